@@ -9,6 +9,7 @@
 
 #include "yaml-cpp/anchor.h"
 #include <map>
+#include <vector>
 
 namespace YAML {
 class Node;
@@ -24,8 +25,20 @@ class AliasManager {
   anchor_t _CreateNewAnchor();
 
  private:
+  // indexed by the anchor each aliased node was parsed with, which is only
+  // unique within a document; a node from another document (or a clone)
+  // that finds its slot taken goes in m_otherAnchors instead
+  struct Entry {
+    Entry() : pNode(0), anchor(NullAnchor) {}
+
+    const Node* pNode;
+    anchor_t anchor;
+  };
+  typedef std::vector<Entry> AnchorByAlias;
+  AnchorByAlias m_anchorByAlias;
+
   typedef std::map<const Node*, anchor_t> AnchorByIdentity;
-  AnchorByIdentity m_anchorByIdentity;
+  AnchorByIdentity m_otherAnchors;
 
   anchor_t m_curAnchor;
 };
@@ -19,6 +19,66 @@ YAML_CPP_API std::string EncodeBase64(const unsigned char* data,
                                       std::size_t size);
 YAML_CPP_API std::vector<unsigned char> DecodeBase64(const std::string& input);
 
+// Base64Kernel
+// . What encodes and decodes runs of whole groups, for all of the above:
+//   SSSE3 or AVX2 where the CPU has them (on x86 with GCC or Clang), or
+//   lookup tables everywhere else and for the ends of runs.
+// . The best the CPU supports is picked on first use. SetBase64Kernel is
+//   for comparing them (in tests and util/bench); it isn't thread-safe, and
+//   returns false if the CPU (or the build) can't run that kernel.
+struct Base64Kernel {
+  enum value { Tables, Ssse3, Avx2 };
+};
+
+YAML_CPP_API Base64Kernel::value GetBase64Kernel();
+YAML_CPP_API bool SetBase64Kernel(Base64Kernel::value kernel);
+
+// Base64Encoder
+// . Encodes bytes a chunk at a time, appending to 'output'. Bytes that don't
+//   make a whole group of three wait for the next chunk; Finish() pads
+//   whatever is left over.
+class YAML_CPP_API Base64Encoder {
+ public:
+  Base64Encoder() : m_heldSize(0) {}
+
+  void Encode(const unsigned char* data, std::size_t size,
+              std::string& output);
+  void Finish(std::string& output);
+
+ private:
+  unsigned char m_held[2];
+  std::size_t m_heldSize;
+};
+
+// Base64Decoder
+// . Decodes base64 a chunk at a time (split anywhere), skipping whitespace.
+// . The first overload writes to 'output', which needs room for
+//   MaxDecodedSize(size) bytes, and returns how many it wrote; the second
+//   appends to 'output'.
+// . A character that isn't base64 fails the decoder: that chunk's output is
+//   dropped, and so is everything after it, until Reset().
+class YAML_CPP_API Base64Decoder {
+ public:
+  Base64Decoder() { Reset(); }
+
+  static std::size_t MaxDecodedSize(std::size_t size) {
+    return (size + 3) / 4 * 3;
+  }
+
+  std::size_t Decode(const char* data, std::size_t size,
+                     unsigned char* output);
+  bool Decode(const char* data, std::size_t size,
+              std::vector<unsigned char>& output);
+  bool failed() const { return m_failed; }
+  void Reset();
+
+ private:
+  unsigned m_value;
+  int m_count;
+  bool m_lastWasPad;
+  bool m_failed;
+};
+
 class YAML_CPP_API Binary {
  public:
   Binary() : m_unownedData(0), m_unownedSize(0) {}
@@ -65,7 +125,36 @@ class YAML_CPP_API Binary {
   std::size_t m_unownedSize;
 };
 
+// BinaryStream
+// . A !!binary node whose bytes come from 'producer', a chunk at a time, so
+//   they never all have to be in memory at once:
+//     std::size_t ReadFile(void* context, unsigned char* buffer,
+//                          std::size_t size);
+//     out << YAML::BinaryStream(ReadFile, &file);
+// . The producer fills up to 'size' bytes of 'buffer', and returns how many
+//   it did; 0 means there are no more.
+// . Outside flow collections, it's emitted as a literal block, wrapped at
+//   76 characters.
+struct BinaryStream {
+  typedef std::size_t (*Producer)(void* context, unsigned char* buffer,
+                                  std::size_t size);
+
+  BinaryStream(Producer producer_, void* context_)
+      : producer(producer_), context(context_) {}
+
+  Producer producer;
+  void* context;
+};
+
 YAML_CPP_API void operator>>(const Node& node, Binary& binary);
+
+// DecodeBinary
+// . Decodes a !!binary node straight from its scalar into 'buffer', and sets
+//   'size' to how much it wrote. A buffer of 3/4 the scalar's size (plus 3)
+//   is always enough; a smaller one is fine if the data fits.
+// . Fails if the node isn't a scalar, isn't base64, or doesn't fit.
+YAML_CPP_API bool DecodeBinary(const Node& node, unsigned char* buffer,
+                               std::size_t capacity, std::size_t& size);
 }
 
 #endif  // BASE64_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -7,8 +7,11 @@
 #pragma once
 #endif
 
+#include <cstring>
+#include <istream>
 #include <limits>
-#include <sstream>
+#include <locale>
+#include <streambuf>
 #include <string>
 
 #include "yaml-cpp/dll.h"
@@ -41,53 +44,201 @@ struct is_scalar_convertible<_Null> {
 };
 
 // actual conversion
+// . Each conversion reads a view (pointer and length) of the scalar; the
+//   std::string overloads just forward to it.
+
+inline bool Convert(const char* input, std::size_t size, std::string& output) {
+  output.assign(input, size);
+  return true;
+}
 
 inline bool Convert(const std::string& input, std::string& output) {
   output = input;
   return true;
 }
 
-YAML_CPP_API bool Convert(const std::string& input, bool& output);
-YAML_CPP_API bool Convert(const std::string& input, _Null& output);
+// ScalarKeyword
+// . What a scalar means as a bool or null: y/yes/true/on, n/no/false/off,
+//   or ~/null/(empty), each in lowercase, UPPERCASE, or Capitalized.
+struct ScalarKeyword {
+  enum value { None, True, False, Null };
+};
+
+YAML_CPP_API ScalarKeyword::value ClassifyKeyword(const char* input,
+                                                  std::size_t size);
+
+YAML_CPP_API bool Convert(const char* input, std::size_t size, bool& output);
+YAML_CPP_API bool Convert(const char* input, std::size_t size, _Null& output);
+
+inline bool Convert(const std::string& input, bool& output) {
+  return Convert(input.data(), input.size(), output);
+}
+
+inline bool Convert(const std::string& input, _Null& output) {
+  return Convert(input.data(), input.size(), output);
+}
+
+inline bool IsScalarEqual(const char* input, std::size_t size,
+                          const char* str) {
+  return std::strlen(str) == size && std::memcmp(input, str, size) == 0;
+}
+
+inline bool IsInfinity(const char* input, std::size_t size) {
+  return IsScalarEqual(input, size, ".inf") ||
+         IsScalarEqual(input, size, ".Inf") ||
+         IsScalarEqual(input, size, ".INF") ||
+         IsScalarEqual(input, size, "+.inf") ||
+         IsScalarEqual(input, size, "+.Inf") ||
+         IsScalarEqual(input, size, "+.INF");
+}
+
+inline bool IsNegativeInfinity(const char* input, std::size_t size) {
+  return IsScalarEqual(input, size, "-.inf") ||
+         IsScalarEqual(input, size, "-.Inf") ||
+         IsScalarEqual(input, size, "-.INF");
+}
+
+inline bool IsNaN(const char* input, std::size_t size) {
+  return IsScalarEqual(input, size, ".nan") ||
+         IsScalarEqual(input, size, ".NaN") ||
+         IsScalarEqual(input, size, ".NAN");
+}
 
 inline bool IsInfinity(const std::string& input) {
-  return input == ".inf" || input == ".Inf" || input == ".INF" ||
-         input == "+.inf" || input == "+.Inf" || input == "+.INF";
+  return IsInfinity(input.data(), input.size());
 }
 
 inline bool IsNegativeInfinity(const std::string& input) {
-  return input == "-.inf" || input == "-.Inf" || input == "-.INF";
+  return IsNegativeInfinity(input.data(), input.size());
 }
 
 inline bool IsNaN(const std::string& input) {
-  return input == ".nan" || input == ".NaN" || input == ".NAN";
+  return IsNaN(input.data(), input.size());
 }
 
+// scalar_streambuf
+// . Reads straight out of a scalar, so extracting from it doesn't copy it.
+class scalar_streambuf : public std::streambuf {
+ public:
+  scalar_streambuf(const char* input, std::size_t size) {
+    char* begin = const_cast<char*>(input);
+    setg(begin, begin, begin + size);
+  }
+};
+
+// number parsing
+// . Integers are decimal, hex (0x), or octal (0o, or a leading 0), as
+//   with stream extraction; floating point numbers are decimal.
+// . Neither depends on the global locale or allocates; numbers whose
+//   rounding isn't exact in double arithmetic fall back to the (classic
+//   locale) stream parser, so every result is still correctly rounded.
+
+// ParseInteger
+// . Reads the sign and magnitude; returns false if it isn't an integer, or
+//   doesn't fit in an unsigned long long.
+YAML_CPP_API bool ParseInteger(const char* input, std::size_t size,
+                               bool& negative, unsigned long long& magnitude);
+
+YAML_CPP_API bool ParseFloatingPoint(const char* input, std::size_t size,
+                                     float& output);
+YAML_CPP_API bool ParseFloatingPoint(const char* input, std::size_t size,
+                                     double& output);
+
 template <typename T>
-inline bool Convert(const std::string& input, T& output,
-                    typename enable_if<is_numeric<T> >::type* = 0) {
-  std::stringstream stream(input);
+inline bool ConvertStreamable(const char* input, std::size_t size,
+                              T& output) {
+  scalar_streambuf buffer(input, size);
+  std::istream stream(&buffer);
+  stream.imbue(std::locale::classic());
   stream.unsetf(std::ios::dec);
-  if ((stream >> output) && (stream >> std::ws).eof())
+  return (stream >> output) && (stream >> std::ws).eof();
+}
+
+template <typename T>
+inline bool ConvertNumber(const char* input, std::size_t size, T& output) {
+  bool negative = false;
+  unsigned long long magnitude = 0;
+  if (!ParseInteger(input, size, negative, magnitude))
+    return false;
+
+  // as with stream extraction, a negative unsigned number wraps around
+  const unsigned long long max =
+      static_cast<unsigned long long>(std::numeric_limits<T>::max());
+  if (!std::numeric_limits<T>::is_signed) {
+    if (magnitude > max)
+      return false;
+    output = static_cast<T>(magnitude);
+    if (negative)
+      output = static_cast<T>(0 - output);
+    return true;
+  }
+
+  if (!negative || magnitude == 0) {
+    if (magnitude > max)
+      return false;
+    output = static_cast<T>(magnitude);
+  } else {
+    // (negating magnitude - 1 can't overflow, even for the minimum value)
+    if (magnitude > max + 1)
+      return false;
+    output = static_cast<T>(-static_cast<T>(magnitude - 1) - 1);
+  }
+  return true;
+}
+
+// chars read a single character, as with stream extraction
+inline bool ConvertNumber(const char* input, std::size_t size, char& output) {
+  return ConvertStreamable(input, size, output);
+}
+
+inline bool ConvertNumber(const char* input, std::size_t size,
+                          unsigned char& output) {
+  return ConvertStreamable(input, size, output);
+}
+
+inline bool ConvertNumber(const char* input, std::size_t size, float& output) {
+  return ParseFloatingPoint(input, size, output);
+}
+
+inline bool ConvertNumber(const char* input, std::size_t size,
+                          double& output) {
+  return ParseFloatingPoint(input, size, output);
+}
+
+inline bool ConvertNumber(const char* input, std::size_t size,
+                          long double& output) {
+  return ConvertStreamable(input, size, output);
+}
+
+template <typename T>
+inline bool Convert(const char* input, std::size_t size, T& output,
+                    typename enable_if<is_numeric<T> >::type* = 0) {
+  if (ConvertNumber(input, size, output))
     return true;
 
   if (std::numeric_limits<T>::has_infinity) {
-    if (IsInfinity(input)) {
+    if (IsInfinity(input, size)) {
       output = std::numeric_limits<T>::infinity();
       return true;
-    } else if (IsNegativeInfinity(input)) {
+    } else if (IsNegativeInfinity(input, size)) {
       output = -std::numeric_limits<T>::infinity();
       return true;
     }
   }
 
-  if (std::numeric_limits<T>::has_quiet_NaN && IsNaN(input)) {
+  if (std::numeric_limits<T>::has_quiet_NaN && IsNaN(input, size)) {
     output = std::numeric_limits<T>::quiet_NaN();
     return true;
   }
 
   return false;
 }
+
+template <typename T>
+inline bool Convert(const std::string& input, T& output,
+                    typename enable_if<is_numeric<T> >::type* = 0) {
+  return Convert(input.data(), input.size(), output);
+}
 }
 
 #endif  // CONVERSION_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -23,6 +23,8 @@ class Emitter;
 class EmitFromEvents : public EventHandler {
  public:
   EmitFromEvents(Emitter& emitter);
+  // emits every collection in 'style' (or, for Default, as it was written)
+  EmitFromEvents(Emitter& emitter, EmitterStyle::value style);
 
   virtual void OnDocumentStart(const Mark& mark);
   virtual void OnDocumentEnd();
@@ -43,9 +45,11 @@ class EmitFromEvents : public EventHandler {
  private:
   void BeginNode();
   void EmitProps(const std::string& tag, anchor_t anchor);
+  void EmitStyle(EmitterStyle::value style);
 
  private:
   Emitter& m_emitter;
+  EmitterStyle::value m_style;
 
   struct State {
     enum value { WaitingForSequenceEntry, WaitingForKey, WaitingForValue };
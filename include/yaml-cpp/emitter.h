@@ -19,9 +19,11 @@
 #include "yaml-cpp/noncopyable.h"
 #include "yaml-cpp/null.h"
 #include "yaml-cpp/ostream_wrapper.h"
+#include "yaml-cpp/outputsink.h"
 
 namespace YAML {
 class Binary;
+struct BinaryStream;
 struct _Null;
 }  // namespace YAML
 
@@ -31,13 +33,29 @@ class EmitterState;
 class YAML_CPP_API Emitter : private noncopyable {
  public:
   Emitter();
+  explicit Emitter(std::size_t reserveSize);
   explicit Emitter(std::ostream& stream);
+  Emitter(std::ostream& stream, std::size_t blockSize);
+  explicit Emitter(OutputSink& sink);
+  Emitter(OutputSink& sink, std::size_t blockSize);
   ~Emitter();
 
   // output
   const char* c_str() const;
   std::size_t size() const;
 
+  // makes room for 'size' characters of output (if it's not to a stream)
+  void Reserve(std::size_t size);
+  // swaps the output into 'output' (without copying it), then Resets
+  void TakeOutput(std::string& output);
+
+  // writes what's buffered to the stream or sink (the destructor also does)
+  void Flush();
+
+  // starts a new output, with the default settings, but keeps the memory
+  // this Emitter has allocated (what's buffered for a stream is flushed)
+  void Reset();
+
   // state checking
   bool good() const;
   const std::string GetLastError() const;
@@ -70,6 +88,7 @@ class YAML_CPP_API Emitter : private noncopyable {
   Emitter& Write(const _Comment& comment);
   Emitter& Write(const _Null& n);
   Emitter& Write(const Binary& binary);
+  Emitter& Write(const BinaryStream& binary);
 
   template <typename T>
   Emitter& WriteIntegralType(T value);
@@ -77,13 +96,31 @@ class YAML_CPP_API Emitter : private noncopyable {
   template <typename T>
   Emitter& WriteStreamable(T value);
 
+  // a sequence of 'count' values, as if each were written between BeginSeq
+  // and EndSeq; numbers are formatted together, in one loop
+  template <typename T>
+  Emitter& WriteSeq(const T* values, std::size_t count);
+  Emitter& WriteSeq(const short* values, std::size_t count);
+  Emitter& WriteSeq(const unsigned short* values, std::size_t count);
+  Emitter& WriteSeq(const int* values, std::size_t count);
+  Emitter& WriteSeq(const unsigned int* values, std::size_t count);
+  Emitter& WriteSeq(const long* values, std::size_t count);
+  Emitter& WriteSeq(const unsigned long* values, std::size_t count);
+  Emitter& WriteSeq(const long long* values, std::size_t count);
+  Emitter& WriteSeq(const unsigned long long* values, std::size_t count);
+  Emitter& WriteSeq(const float* values, std::size_t count);
+  Emitter& WriteSeq(const double* values, std::size_t count);
+
  private:
   template <typename T>
-  void SetStreamablePrecision(std::stringstream&) {}
+  Emitter& WriteNumberSeq(const T* values, std::size_t count);
+
+  void WriteIntegralBits(unsigned long long bits, bool negative,
+                         std::size_t size);
+  void WriteFloatingPoint(double value, std::size_t precision);
   std::size_t GetFloatPrecision() const;
   std::size_t GetDoublePrecision() const;
 
-  void PrepareIntegralStream(std::stringstream& stream) const;
   void StartedScalar();
 
  private:
@@ -132,12 +169,8 @@ inline Emitter& Emitter::WriteIntegralType(T value) {
     return *this;
 
   PrepareNode(EmitterNodeType::Scalar);
-
-  std::stringstream stream;
-  PrepareIntegralStream(stream);
-  stream << value;
-  m_stream << stream.str();
-
+  WriteIntegralBits(static_cast<unsigned long long>(value), value < T(),
+                    sizeof(T));
   StartedScalar();
 
   return *this;
@@ -151,7 +184,6 @@ inline Emitter& Emitter::WriteStreamable(T value) {
   PrepareNode(EmitterNodeType::Scalar);
 
   std::stringstream stream;
-  SetStreamablePrecision<T>(stream);
   stream << value;
   m_stream << stream.str();
 
@@ -161,13 +193,27 @@ inline Emitter& Emitter::WriteStreamable(T value) {
 }
 
 template <>
-inline void Emitter::SetStreamablePrecision<float>(std::stringstream& stream) {
-  stream.precision(GetFloatPrecision());
+inline Emitter& Emitter::WriteStreamable<float>(float value) {
+  if (!good())
+    return *this;
+
+  PrepareNode(EmitterNodeType::Scalar);
+  WriteFloatingPoint(value, GetFloatPrecision());
+  StartedScalar();
+
+  return *this;
 }
 
 template <>
-inline void Emitter::SetStreamablePrecision<double>(std::stringstream& stream) {
-  stream.precision(GetDoublePrecision());
+inline Emitter& Emitter::WriteStreamable<double>(double value) {
+  if (!good())
+    return *this;
+
+  PrepareNode(EmitterNodeType::Scalar);
+  WriteFloatingPoint(value, GetDoublePrecision());
+  StartedScalar();
+
+  return *this;
 }
 
 // overloads of insertion
@@ -201,6 +247,9 @@ inline Emitter& operator<<(Emitter& emitter, const _Null& v) {
 inline Emitter& operator<<(Emitter& emitter, const Binary& b) {
   return emitter.Write(b);
 }
+inline Emitter& operator<<(Emitter& emitter, const BinaryStream& b) {
+  return emitter.Write(b);
+}
 
 inline Emitter& operator<<(Emitter& emitter, const char* v) {
   return emitter.Write(std::string(v));
@@ -242,6 +291,15 @@ inline Emitter& operator<<(Emitter& emitter, EMITTER_MANIP value) {
   return emitter.SetLocalValue(value);
 }
 
+template <typename T>
+inline Emitter& Emitter::WriteSeq(const T* values, std::size_t count) {
+  *this << BeginSeq;
+  for (std::size_t i = 0; i < count; i++)
+    *this << values[i];
+  *this << EndSeq;
+  return *this;
+}
+
 inline Emitter& operator<<(Emitter& emitter, _Indent indent) {
   return emitter.SetLocalIndent(indent);
 }
@@ -11,6 +11,7 @@
 
 #include "yaml-cpp/anchor.h"
 #include "yaml-cpp/emitterstyle.h"
+#include "yaml-cpp/scalarhint.h"
 
 namespace YAML {
 struct Mark;
@@ -27,6 +28,14 @@ class EventHandler {
   virtual void OnScalar(const Mark& mark, const std::string& tag,
                         anchor_t anchor, const std::string& value) = 0;
 
+  // the parser reports scalars here, with the scanner's type hint; by
+  // default, we drop the hint
+  virtual void OnScalarWithHint(const Mark& mark, const std::string& tag,
+                                anchor_t anchor, const std::string& value,
+                                ScalarHint::value /*hint*/) {
+    OnScalar(mark, tag, anchor, value);
+  }
+
   virtual void OnSequenceStart(const Mark& mark, const std::string& tag,
                                anchor_t anchor, EmitterStyle::value style) = 0;
   virtual void OnSequenceEnd() = 0;
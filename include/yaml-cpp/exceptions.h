@@ -90,6 +90,10 @@ const char* const SINGLE_QUOTED_CHAR =
 const char* const INVALID_ANCHOR = "invalid anchor";
 const char* const INVALID_ALIAS = "invalid alias";
 const char* const INVALID_TAG = "invalid tag";
+const char* const INVALID_INDENT = "invalid indent";
+const char* const INVALID_STRING_FORMAT = "invalid string format";
+const char* const JSON_COLLECTION_KEY = "a JSON key must be a scalar";
+const char* const JSON_MISSING_VALUE = "a JSON key must have a value";
 
 template <typename T>
 inline const std::string KEY_NOT_FOUND_WITH_KEY(
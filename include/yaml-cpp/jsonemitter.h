@@ -0,0 +1,195 @@
+#ifndef JSONEMITTER_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define JSONEMITTER_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <cstddef>
+#include <cstring>
+#include <iosfwd>
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "yaml-cpp/dll.h"
+#include "yaml-cpp/emittermanip.h"
+#include "yaml-cpp/noncopyable.h"
+#include "yaml-cpp/null.h"
+#include "yaml-cpp/ostream_wrapper.h"
+#include "yaml-cpp/outputsink.h"
+
+namespace YAML {
+// JsonEmitter
+// . Takes the same << stream as an Emitter (BeginSeq, Key, Value, scalars,
+//   Null, ...), but writes minified JSON: strings are always quoted, there's
+//   no whitespace, and none of the YAML layout is worked out.
+// . Key and Value are optional (a map's entries alternate), and formatting
+//   manipulators (Flow, DoubleQuoted, Hex, ...) are ignored. Keys that
+//   aren't strings are quoted; each top-level value goes on its own line.
+// . Non-finite floats are written as null.
+class YAML_CPP_API JsonEmitter : private noncopyable {
+ public:
+  JsonEmitter();
+  explicit JsonEmitter(std::ostream& stream);
+  explicit JsonEmitter(OutputSink& sink);
+  ~JsonEmitter();
+
+  // output
+  const char* c_str() const;
+  std::size_t size() const;
+  void Flush();
+
+  // state checking
+  bool good() const;
+  const std::string GetLastError() const;
+
+  // global setters
+  bool SetFloatPrecision(std::size_t n);
+  bool SetDoublePrecision(std::size_t n);
+
+  JsonEmitter& SetLocalValue(EMITTER_MANIP value);
+
+  // overloads of write
+  JsonEmitter& Write(const std::string& str);
+  JsonEmitter& Write(const char* str, std::size_t size);
+  JsonEmitter& Write(bool b);
+  JsonEmitter& Write(char ch);
+  JsonEmitter& Write(const _Null& n);
+  JsonEmitter& WriteFloatingPoint(double value, std::size_t precision);
+
+  template <typename T>
+  JsonEmitter& WriteIntegralType(T value);
+
+  std::size_t GetFloatPrecision() const { return m_floatPrecision; }
+  std::size_t GetDoublePrecision() const { return m_doublePrecision; }
+
+ private:
+  struct Group {
+    bool isMap;
+    std::size_t childCount;
+  };
+
+  bool PrepareNode();
+  void BeginGroup(bool isMap);
+  void EndGroup(bool isMap);
+  void WriteIntegralBits(unsigned long long bits, bool negative, bool key);
+  void SetError(const std::string& error);
+
+ private:
+  ostream_wrapper m_stream;
+  std::vector<Group> m_groups;
+  std::size_t m_docCount;
+  std::size_t m_floatPrecision;
+  std::size_t m_doublePrecision;
+  bool m_isGood;
+  std::string m_lastError;
+};
+
+template <typename T>
+inline JsonEmitter& JsonEmitter::WriteIntegralType(T value) {
+  if (!good())
+    return *this;
+
+  const bool key = PrepareNode();
+  WriteIntegralBits(static_cast<unsigned long long>(value), value < T(), key);
+  return *this;
+}
+
+// overloads of insertion
+inline JsonEmitter& operator<<(JsonEmitter& emitter, const std::string& v) {
+  return emitter.Write(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, const char* v) {
+  return emitter.Write(v, std::strlen(v));
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, bool v) {
+  return emitter.Write(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, char v) {
+  return emitter.Write(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, unsigned char v) {
+  return emitter.Write(static_cast<char>(v));
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, const _Null& v) {
+  return emitter.Write(v);
+}
+
+inline JsonEmitter& operator<<(JsonEmitter& emitter, int v) {
+  return emitter.WriteIntegralType(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, unsigned int v) {
+  return emitter.WriteIntegralType(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, short v) {
+  return emitter.WriteIntegralType(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, unsigned short v) {
+  return emitter.WriteIntegralType(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, long v) {
+  return emitter.WriteIntegralType(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, unsigned long v) {
+  return emitter.WriteIntegralType(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, long long v) {
+  return emitter.WriteIntegralType(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, unsigned long long v) {
+  return emitter.WriteIntegralType(v);
+}
+
+inline JsonEmitter& operator<<(JsonEmitter& emitter, float v) {
+  return emitter.WriteFloatingPoint(v, emitter.GetFloatPrecision());
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, double v) {
+  return emitter.WriteFloatingPoint(v, emitter.GetDoublePrecision());
+}
+
+inline JsonEmitter& operator<<(JsonEmitter& emitter, EMITTER_MANIP value) {
+  return emitter.SetLocalValue(value);
+}
+
+// STL containers, as in stlemitter.h
+template <typename Seq>
+inline JsonEmitter& EmitSeq(JsonEmitter& emitter, const Seq& seq) {
+  emitter << BeginSeq;
+  for (typename Seq::const_iterator it = seq.begin(); it != seq.end(); ++it)
+    emitter << *it;
+  emitter << EndSeq;
+  return emitter;
+}
+
+template <typename T>
+inline JsonEmitter& operator<<(JsonEmitter& emitter, const std::vector<T>& v) {
+  return EmitSeq(emitter, v);
+}
+
+template <typename T>
+inline JsonEmitter& operator<<(JsonEmitter& emitter, const std::list<T>& v) {
+  return EmitSeq(emitter, v);
+}
+
+template <typename T>
+inline JsonEmitter& operator<<(JsonEmitter& emitter, const std::set<T>& v) {
+  return EmitSeq(emitter, v);
+}
+
+template <typename K, typename V>
+inline JsonEmitter& operator<<(JsonEmitter& emitter, const std::map<K, V>& m) {
+  typedef typename std::map<K, V> map;
+  emitter << BeginMap;
+  for (typename map::const_iterator it = m.begin(); it != m.end(); ++it)
+    emitter << it->first << it->second;
+  emitter << EndMap;
+  return emitter;
+}
+}
+
+#endif  // JSONEMITTER_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -13,6 +13,7 @@
 #include <string>
 #include <vector>
 
+#include "yaml-cpp/anchor.h"
 #include "yaml-cpp/conversion.h"
 #include "yaml-cpp/dll.h"
 #include "yaml-cpp/emitterstyle.h"
@@ -21,6 +22,7 @@
 #include "yaml-cpp/ltnode.h"
 #include "yaml-cpp/mark.h"
 #include "yaml-cpp/noncopyable.h"
+#include "yaml-cpp/scalarhint.h"
 #include "yaml-cpp/traits.h"
 
 namespace YAML {
@@ -35,6 +37,7 @@ class Emitter;
 class EventHandler;
 class NodeOwnership;
 class Scanner;
+class StringPool;
 
 struct NodeType {
   enum value { Null, Scalar, Sequence, Map };
@@ -42,6 +45,7 @@ struct NodeType {
 
 class YAML_CPP_API Node : private noncopyable {
  public:
+  friend class AliasManager;
   friend class NodeOwnership;
   friend class NodeBuilder;
 
@@ -54,7 +58,7 @@ class YAML_CPP_API Node : private noncopyable {
   void EmitEvents(AliasManager& am, EventHandler& eventHandler) const;
 
   NodeType::value Type() const { return m_type; }
-  bool IsAliased() const;
+  bool IsAliased() const { return m_aliasAnchor != NullAnchor; }
 
   // file location of start of this node
   const Mark GetMark() const { return m_mark; }
@@ -67,6 +71,20 @@ class YAML_CPP_API Node : private noncopyable {
   // extraction of scalars
   bool GetScalar(std::string& s) const;
 
+  // ... and without copying them (a null node reads as "~")
+  bool GetScalar(const char*& data, std::size_t& size) const;
+  const std::string& Scalar() const;  // throws InvalidScalar if not a scalar
+
+  // what the scanner saw of a scalar (Null for a null node, and Unknown for a
+  // collection)
+  ScalarHint::value Hint() const;
+
+  // parses every scalar in this tree once as the types Read<T>() is most
+  // often asked for (integers, double, bool and null), so that reading them
+  // again and again doesn't parse them again; call it before sharing the
+  // tree between threads
+  void CacheConversions();
+
   // we can specialize this for other values
   template <typename T>
   bool Read(T& value) const;
@@ -74,10 +92,18 @@ class YAML_CPP_API Node : private noncopyable {
   template <typename T>
   const T to() const;
 
+  // reads a sequence of scalars into 'values' (replacing its contents); if it
+  // fails, values.size() is the index of the element that didn't convert
+  template <typename T>
+  bool ReadSequence(std::vector<T>& values) const;
+
   template <typename T>
   friend YAML_CPP_API typename enable_if<is_scalar_convertible<T> >::type
       operator>>(const Node& node, T& value);
 
+  template <typename T>
+  friend bool ConvertScalar(const Node& node, T& value);
+
   // retrieval for maps and sequences
   template <typename T>
   const Node* FindValue(const T& key) const;
@@ -92,7 +118,7 @@ class YAML_CPP_API Node : private noncopyable {
   const Node& operator[](char* key) const;
 
   // for tags
-  const std::string& Tag() const { return m_tag; }
+  const std::string& Tag() const { return *m_pTag; }
 
   // emitting
   friend YAML_CPP_API Emitter& operator<<(Emitter& out, const Node& node);
@@ -105,14 +131,40 @@ class YAML_CPP_API Node : private noncopyable {
   explicit Node(NodeOwnership& owner);
   Node& CreateNode();
 
+  // helpers for Clone
+  typedef std::vector<Node*> clone_map;
+  Node& CloneChild(const Node& source, clone_map& clones);
+  void CopyFrom(const Node& source, clone_map& clones);
+
   void Init(NodeType::value type, const Mark& mark, const std::string& tag,
-            EmitterStyle::value style);
+            EmitterStyle::value style, StringPool* pPool = 0);
 
-  void MarkAsAliased();
-  void SetScalarData(const std::string& data);
+  void MarkAsAliased(anchor_t anchor);
+  void SetScalarData(const std::string& data,
+                     ScalarHint::value hint = ScalarHint::Unknown,
+                     StringPool* pPool = 0);
+  void CacheScalarConversions();
   void Append(Node& node);
   void Insert(Node& key, Node& value);
 
+  // helpers for ConvertScalar
+  const std::string* ScalarText() const;
+
+  template <typename T>
+  bool ReadCached(T&, bool&) const {
+    return false;
+  }
+  bool ReadCached(short& value, bool& result) const;
+  bool ReadCached(int& value, bool& result) const;
+  bool ReadCached(long& value, bool& result) const;
+  bool ReadCached(long long& value, bool& result) const;
+  bool ReadCached(double& value, bool& result) const;
+  bool ReadCached(bool& value, bool& result) const;
+  bool ReadCached(_Null& value, bool& result) const;
+
+  template <typename T>
+  bool ReadCachedInteger(T& value, bool& result) const;
+
   // helper for sequences
   template <typename, bool>
   friend struct _FindFromNodeAtIndex;
@@ -124,19 +176,44 @@ class YAML_CPP_API Node : private noncopyable {
 
   template <typename T>
   const Node* FindValueForKey(const T& key) const;
+  const Node* FindValueForKey(const std::string& key) const;
+  const Node* FindValueForKey(const char* key) const;
+  const Node* FindValueForKey(const char* key, std::size_t size) const;
 
  private:
   std::auto_ptr<NodeOwnership> m_pOwnership;
 
   Mark m_mark;
-  std::string m_tag;
+  anchor_t m_aliasAnchor;  // the anchor it was parsed with, if it's aliased
+
+  // a copy we own, a string interned in a StringPool, or a shared empty one
+  const std::string* m_pTag;
   EmitterStyle::value m_style;
 
   typedef std::vector<Node*> node_seq;
   typedef std::map<Node*, Node*, ltnode> node_map;
 
   NodeType::value m_type;
-  std::string m_scalarData;
+  const std::string* m_pScalarData;  // same as m_pTag
+  bool m_ownsTag;
+  bool m_ownsScalarData;
+
+  ScalarHint::value m_hint;
+
+  // a scalar's conversions, if CacheConversions() computed them
+  struct ScalarCache {
+    enum { Integer = 0x1, Double = 0x2, Bool = 0x4, Null = 0x8 };
+
+    ScalarCache()
+        : flags(0), integerValue(0), doubleValue(0.0), boolValue(false) {}
+
+    int flags;
+    long long integerValue;
+    double doubleValue;
+    bool boolValue;
+  };
+  ScalarCache* m_pCache;  // owned
+
   node_seq m_seqData;
   node_map m_mapData;
 };
@@ -9,6 +9,8 @@
 
 #include "yaml-cpp/nodeutil.h"
 #include <cassert>
+#include <cstring>
+#include <limits>
 
 namespace YAML {
 // implementation of templated things
@@ -19,6 +21,97 @@ inline const T Node::to() const {
   return value;
 }
 
+template <typename T>
+inline bool Node::ReadSequence(std::vector<T>& values) const {
+  values.clear();
+  if (m_type != NodeType::Sequence)
+    return false;
+
+  values.reserve(m_seqData.size());
+  for (node_seq::const_iterator it = m_seqData.begin(); it != m_seqData.end();
+       ++it) {
+    T value;
+    if (!(*it)->Read(value))
+      return false;
+    values.push_back(value);
+  }
+  return true;
+}
+
+// ReadCached
+// . Answers a conversion from the scalar's cached conversions.
+// . Returns false if there's no cache, or it doesn't cover T (so we have to
+//   parse it); otherwise 'result' says whether the conversion succeeded.
+template <typename T>
+inline bool Node::ReadCachedInteger(T& value, bool& result) const {
+  result = false;
+  switch (m_type) {
+    case NodeType::Null:
+    case NodeType::Sequence:
+    case NodeType::Map:
+      return true;
+    case NodeType::Scalar:
+      break;
+  }
+
+  if (!m_pCache)
+    return false;
+  if (!(m_pCache->flags & ScalarCache::Integer))
+    return true;
+  if (m_pCache->integerValue < std::numeric_limits<T>::min() ||
+      m_pCache->integerValue > std::numeric_limits<T>::max())
+    return true;
+
+  value = static_cast<T>(m_pCache->integerValue);
+  result = true;
+  return true;
+}
+
+inline bool Node::ReadCached(short& value, bool& result) const {
+  return ReadCachedInteger(value, result);
+}
+
+inline bool Node::ReadCached(int& value, bool& result) const {
+  return ReadCachedInteger(value, result);
+}
+
+inline bool Node::ReadCached(long& value, bool& result) const {
+  return ReadCachedInteger(value, result);
+}
+
+inline bool Node::ReadCached(long long& value, bool& result) const {
+  return ReadCachedInteger(value, result);
+}
+
+inline bool Node::ReadCached(double& value, bool& result) const {
+  if (m_type == NodeType::Scalar && !m_pCache)
+    return false;
+  result = m_type == NodeType::Scalar &&
+           (m_pCache->flags & ScalarCache::Double) != 0;
+  if (result)
+    value = m_pCache->doubleValue;
+  return true;
+}
+
+inline bool Node::ReadCached(bool& value, bool& result) const {
+  if (m_type == NodeType::Scalar && !m_pCache)
+    return false;
+  result = m_type == NodeType::Scalar &&
+           (m_pCache->flags & ScalarCache::Bool) != 0;
+  if (result)
+    value = m_pCache->boolValue;
+  return true;
+}
+
+inline bool Node::ReadCached(_Null& /*value*/, bool& result) const {
+  if (m_type == NodeType::Scalar && !m_pCache)
+    return false;
+  result = m_type == NodeType::Null ||
+           (m_type == NodeType::Scalar &&
+            (m_pCache->flags & ScalarCache::Null) != 0);
+  return true;
+}
+
 template <typename T>
 inline typename enable_if<is_scalar_convertible<T> >::type operator>>(
     const Node& node, T& value) {
@@ -43,11 +136,12 @@ inline const Node* Node::FindValue(const T& key) const {
 
 template <typename T>
 inline const Node* Node::FindValueForKey(const T& key) const {
-  for (Iterator it = begin(); it != end(); ++it) {
+  for (node_map::const_iterator it = m_mapData.begin(); it != m_mapData.end();
+       ++it) {
     T t;
-    if (it.first().Read(t)) {
+    if (it->first->Read(t)) {
       if (key == t)
-        return &it.second();
+        return it->second;
     }
   }
 
@@ -66,20 +160,30 @@ inline const Node& Node::operator[](const T& key) const {
   return GetValue(key);
 }
 
+inline const Node* Node::FindValueForKey(const std::string& key) const {
+  return FindValueForKey(key.data(), key.size());
+}
+
+inline const Node* Node::FindValueForKey(const char* key) const {
+  return FindValueForKey(key, std::strlen(key));
+}
+
 inline const Node* Node::FindValue(const char* key) const {
-  return FindValue(std::string(key));
+  return FindValue<const char*>(key);
 }
 
 inline const Node* Node::FindValue(char* key) const {
-  return FindValue(std::string(key));
+  return FindValue<const char*>(key);
 }
 
 inline const Node& Node::operator[](const char* key) const {
-  return GetValue(std::string(key));
+  if (const Node* pValue = FindValue(key))
+    return *pValue;
+  throw MakeTypedKeyNotFound(m_mark, std::string(key));
 }
 
 inline const Node& Node::operator[](char* key) const {
-  return GetValue(std::string(key));
+  return (*this)[static_cast<const char*>(key)];
 }
 }
 
@@ -26,21 +26,46 @@ inline bool Node::Read(T& value) const {
 }
 #else
 // usual case: the trick!
+namespace fallback {
+// sizeof > 1
+struct flag {
+  char c[2];
+};
+flag Convert(...);
+
+// (any real TryDecode is a better match)
+template <typename T>
+flag TryDecode(const Node&, T&);
+
+int operator, (flag, flag);
+
+template <typename T>
+char operator, (flag, T const&);
+
+char operator, (int, flag);
+int operator, (char, flag);
+}
+
+// TryDecode
+// . A type that isn't a scalar can implement
+//     bool TryDecode(const YAML::Node& node, T& value);
+//   (in its own namespace, or in YAML) to be read without exceptions;
+//   otherwise, we call operator >> and catch what it throws.
 template <bool>
-struct read_impl;
+struct decode_impl;
 
-// ConvertScalar available
+// TryDecode available
 template <>
-struct read_impl<true> {
+struct decode_impl<true> {
   template <typename T>
   static bool read(const Node& node, T& value) {
-    return ConvertScalar(node, value);
+    return TryDecode(node, value);
   }
 };
 
-// ConvertScalar not available
+// TryDecode not available
 template <>
-struct read_impl<false> {
+struct decode_impl<false> {
   template <typename T>
   static bool read(const Node& node, T& value) {
     try {
@@ -53,21 +78,29 @@ struct read_impl<false> {
   }
 };
 
-namespace fallback {
-// sizeof > 1
-struct flag {
-  char c[2];
-};
-flag Convert(...);
+template <bool>
+struct read_impl;
 
-int operator, (flag, flag);
+// ConvertScalar available
+template <>
+struct read_impl<true> {
+  template <typename T>
+  static bool read(const Node& node, T& value) {
+    return ConvertScalar(node, value);
+  }
+};
 
-template <typename T>
-char operator, (flag, T const&);
+// ConvertScalar not available
+template <>
+struct read_impl<false> {
+  template <typename T>
+  static bool read(const Node& node, T& value) {
+    using namespace fallback;
 
-char operator, (int, flag);
-int operator, (char, flag);
-}
+    return decode_impl<sizeof(fallback::flag(), TryDecode(node, value),
+                              fallback::flag()) != 1>::read(node, value);
+  }
+};
 
 template <typename T>
 inline bool Node::Read(T& value) const {
@@ -81,11 +114,17 @@ inline bool Node::Read(T& value) const {
 // the main conversion function
 template <typename T>
 inline bool ConvertScalar(const Node& node, T& value) {
-  std::string scalar;
-  if (!node.GetScalar(scalar))
+  bool result;
+  if (node.ReadCached(value, result))
+    return result;
+  if (!CanConvert(node.Hint(), value))
+    return false;
+
+  const std::string* pScalar = node.ScalarText();
+  if (!pScalar)
     return false;
 
-  return Convert(scalar, value);
+  return Convert(*pScalar, value);
 }
 }
 
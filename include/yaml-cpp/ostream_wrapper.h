@@ -7,31 +7,44 @@
 #pragma once
 #endif
 
+#include <memory>
 #include <string>
-#include <vector>
 
 #include "yaml-cpp/dll.h"
+#include "yaml-cpp/noncopyable.h"
+#include "yaml-cpp/outputsink.h"
 
 namespace YAML {
-class YAML_CPP_API ostream_wrapper {
+// ostream_wrapper
+// . Writes either to its own buffer (see str()) or to a sink (a stream is
+//   written through a StreamSink).
+// . Its own buffer doubles as it grows, so writing is amortized O(1), and
+//   take() hands it over without copying.
+// . A sink is written in blocks of (up to) block_size characters: the
+//   output collects in the block until it fills, or until flush() or the
+//   destructor. A block_size of 0 writes each piece straight through.
+class YAML_CPP_API ostream_wrapper : private noncopyable {
  public:
   ostream_wrapper();
-  explicit ostream_wrapper(std::ostream& stream);
+  explicit ostream_wrapper(std::ostream& stream, std::size_t block_size = 4096);
+  explicit ostream_wrapper(OutputSink& sink, std::size_t block_size = 65536);
   ~ostream_wrapper();
 
   void write(const std::string& str);
   void write(const char* str, std::size_t size);
+  void flush();
+
+  // starts over at the beginning, keeping the buffer (for a sink, what's
+  // buffered is flushed first)
+  void clear();
+  // makes room for 'size' characters of output, if it's to our own buffer
+  void reserve(std::size_t size);
+  // swaps our own buffer (or nothing, for a sink) into 'output', then clears
+  void take(std::string& output);
 
   void set_comment() { m_comment = true; }
 
-  const char* str() const {
-    if (m_pStream) {
-      return 0;
-    } else {
-      m_buffer[m_pos] = '\0';
-      return &m_buffer[0];
-    }
-  }
+  const char* str() const { return m_pSink ? 0 : m_buffer.c_str(); }
 
   std::size_t row() const { return m_row; }
   std::size_t col() const { return m_col; }
@@ -39,13 +52,15 @@ class YAML_CPP_API ostream_wrapper {
   bool comment() const { return m_comment; }
 
  private:
-  void update_pos(char ch);
+  void update_pos(const char* str, std::size_t size);
 
  private:
-  mutable std::vector<char> m_buffer;
-  std::ostream* const m_pStream;
+  std::string m_buffer;  // or the block, for a sink
+  std::auto_ptr<OutputSink> m_pStreamSink;
+  OutputSink* const m_pSink;
 
   std::size_t m_pos;
+  std::size_t m_flushed;  // how much of it is in the sink
   std::size_t m_row, m_col;
   bool m_comment;
 };
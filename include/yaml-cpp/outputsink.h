@@ -0,0 +1,97 @@
+#ifndef OUTPUTSINK_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define OUTPUTSINK_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <cstddef>
+#include <iosfwd>
+
+#include "yaml-cpp/dll.h"
+#include "yaml-cpp/noncopyable.h"
+
+namespace YAML {
+// OutputSink
+// . Where an Emitter (through its ostream_wrapper) sends its output, one
+//   block at a time:
+//     YAML::FileDescriptorSink sink(fd);
+//     YAML::Emitter out(sink);
+// . Write is given everything, and should report its own failures; like a
+//   std::ostream, the emitter doesn't check.
+class YAML_CPP_API OutputSink : private noncopyable {
+ public:
+  virtual ~OutputSink() {}
+  virtual void Write(const char* data, std::size_t size) = 0;
+};
+
+// StreamSink
+// . Writes to a std::ostream (this is what Emitter(std::ostream&) uses).
+class YAML_CPP_API StreamSink : public OutputSink {
+ public:
+  explicit StreamSink(std::ostream& stream) : m_stream(stream) {}
+  virtual void Write(const char* data, std::size_t size);
+
+ private:
+  std::ostream& m_stream;
+};
+
+// FileDescriptorSink
+// . Writes to a file descriptor (which it doesn't close), retrying partial
+//   writes; after an error, it stops writing and keeps the errno.
+class YAML_CPP_API FileDescriptorSink : public OutputSink {
+ public:
+  explicit FileDescriptorSink(int fd) : m_fd(fd), m_error(0) {}
+  virtual void Write(const char* data, std::size_t size);
+
+  bool failed() const { return m_error != 0; }
+  int error() const { return m_error; }
+
+ private:
+  int m_fd;
+  int m_error;
+};
+
+// FixedBufferSink
+// . Writes into a buffer the caller owns. Once the output doesn't fit, the
+//   rest of it is dropped and overflowed() says so; size() is how much did.
+class YAML_CPP_API FixedBufferSink : public OutputSink {
+ public:
+  FixedBufferSink(char* buffer, std::size_t capacity)
+      : m_buffer(buffer),
+        m_capacity(capacity),
+        m_size(0),
+        m_overflowed(false) {}
+  virtual void Write(const char* data, std::size_t size);
+
+  std::size_t size() const { return m_size; }
+  bool overflowed() const { return m_overflowed; }
+
+ private:
+  char* m_buffer;
+  std::size_t m_capacity;
+  std::size_t m_size;
+  bool m_overflowed;
+};
+
+// CallbackSink
+// . Hands each block to a function, e.g. to send it as it's produced.
+class YAML_CPP_API CallbackSink : public OutputSink {
+ public:
+  typedef void (*Callback)(void* context, const char* data, std::size_t size);
+
+  CallbackSink(Callback callback, void* context)
+      : m_callback(callback), m_context(context) {}
+  virtual void Write(const char* data, std::size_t size) {
+    m_callback(m_context, data, size);
+  }
+
+ private:
+  Callback m_callback;
+  void* m_context;
+};
+}
+
+#endif  // OUTPUTSINK_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -17,6 +17,7 @@ namespace YAML {
 class EventHandler;
 class Node;
 class Scanner;
+class StringPool;
 struct Directives;
 struct Mark;
 struct Token;
@@ -33,6 +34,7 @@ class YAML_CPP_API Parser : private noncopyable {
   bool HandleNextDocument(EventHandler& eventHandler);
 
   bool GetNextDocument(Node& document);  // old API only
+  bool GetNextDocument(Node& document, StringPool& pool);  // old API only
 
   void PrintTokens(std::ostream& out);
 
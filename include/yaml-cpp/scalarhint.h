@@ -0,0 +1,72 @@
+#ifndef SCALARHINT_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define SCALARHINT_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <cstddef>
+#include <limits>
+
+#include "yaml-cpp/dll.h"
+#include "yaml-cpp/null.h"
+#include "yaml-cpp/traits.h"
+
+namespace YAML {
+// ScalarHint
+// . What the scanner saw of a scalar: whether it was quoted (or a block
+//   scalar), and if not, which type its text resolves to.
+// . The types follow Convert's syntax: Int is anything written as an integer,
+//   Float anything else written as a double, and Null and Bool are
+//   ClassifyKeyword's. Only the range isn't checked, so an Int or Float may
+//   still be too big to convert.
+struct ScalarHint {
+  enum value { Unknown, Quoted, Null, Bool, Int, Float, String };
+};
+
+YAML_CPP_API ScalarHint::value ClassifyPlainScalar(const char* input,
+                                                   std::size_t size);
+
+inline bool IsPlainHint(ScalarHint::value hint) {
+  return hint != ScalarHint::Unknown && hint != ScalarHint::Quoted;
+}
+
+// CanConvert
+// . Returns false if a scalar with this hint certainly won't convert to T,
+//   so a typed read can fail without parsing it.
+template <typename T>
+inline bool CanConvert(ScalarHint::value /*hint*/, const T&,
+                       typename disable_if<is_numeric<T> >::type* = 0) {
+  return true;
+}
+
+template <typename T>
+inline bool CanConvert(ScalarHint::value hint, const T&,
+                       typename enable_if<is_numeric<T> >::type* = 0) {
+  if (!IsPlainHint(hint))
+    return true;
+  if (std::numeric_limits<T>::is_integer)
+    return hint == ScalarHint::Int;
+  return hint == ScalarHint::Int || hint == ScalarHint::Float;
+}
+
+// chars read any single character, and long doubles have more range than
+// Float promises
+inline bool CanConvert(ScalarHint::value, const char&) { return true; }
+inline bool CanConvert(ScalarHint::value, const unsigned char&) {
+  return true;
+}
+inline bool CanConvert(ScalarHint::value, const long double&) { return true; }
+
+inline bool CanConvert(ScalarHint::value hint, const bool&) {
+  return !IsPlainHint(hint) || hint == ScalarHint::Bool;
+}
+
+inline bool CanConvert(ScalarHint::value hint, const _Null&) {
+  return !IsPlainHint(hint) || hint == ScalarHint::Null;
+}
+}
+
+#endif  // SCALARHINT_H_62B23520_7C8E_11DE_8A39_0800200C9A66
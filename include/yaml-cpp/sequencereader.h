@@ -0,0 +1,130 @@
+#ifndef SEQUENCEREADER_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define SEQUENCEREADER_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <string>
+#include <vector>
+
+#include "yaml-cpp/anchor.h"
+#include "yaml-cpp/conversion.h"
+#include "yaml-cpp/emitterstyle.h"
+#include "yaml-cpp/eventhandler.h"
+#include "yaml-cpp/mark.h"
+#include "yaml-cpp/noncopyable.h"
+#include "yaml-cpp/scalarhint.h"
+
+namespace YAML {
+// SequenceReader
+// . Reads a document that's a sequence of scalars straight into 'values',
+//   without building a Node:
+//     std::vector<int> values;
+//     SequenceReader<int> reader(values);
+//     parser.HandleNextDocument(reader);
+// . If it fails, values.size() is the index of the element that didn't
+//   convert (or 0 if the document isn't a sequence).
+template <typename T>
+class SequenceReader : public EventHandler, private noncopyable {
+ public:
+  explicit SequenceReader(std::vector<T>& values)
+      : m_values(values), m_depth(0), m_failed(false) {}
+
+  bool failed() const { return m_failed; }
+  const Mark& failedMark() const { return m_failedMark; }
+
+  virtual void OnDocumentStart(const Mark&) {
+    m_values.clear();
+    m_anchors.clear();
+    m_depth = 0;
+    m_failed = false;
+    m_failedMark = Mark();
+  }
+  virtual void OnDocumentEnd() {}
+
+  virtual void OnNull(const Mark& mark, anchor_t anchor) {
+    OnScalarWithHint(mark, "", anchor, "~", ScalarHint::Null);
+  }
+
+  virtual void OnAlias(const Mark& mark, anchor_t anchor) {
+    if (!Accept(mark))
+      return;
+    if (anchor >= m_anchors.size() || m_anchors[anchor] == 0) {
+      Fail(mark);
+      return;
+    }
+    m_values.push_back(m_values[m_anchors[anchor] - 1]);
+  }
+
+  virtual void OnScalar(const Mark& mark, const std::string& tag,
+                        anchor_t anchor, const std::string& value) {
+    OnScalarWithHint(mark, tag, anchor, value, ScalarHint::Unknown);
+  }
+
+  virtual void OnScalarWithHint(const Mark& mark, const std::string&,
+                                anchor_t anchor, const std::string& value,
+                                ScalarHint::value hint) {
+    if (!Accept(mark))
+      return;
+
+    T element;
+    if (!CanConvert(hint, element) || !Convert(value, element)) {
+      Fail(mark);
+      return;
+    }
+    if (anchor != NullAnchor) {
+      if (anchor >= m_anchors.size())
+        m_anchors.resize(anchor + 1);
+      m_anchors[anchor] = m_values.size() + 1;
+    }
+    m_values.push_back(element);
+  }
+
+  virtual void OnSequenceStart(const Mark& mark, const std::string&, anchor_t,
+                               EmitterStyle::value) {
+    // the outermost sequence is the one we're reading
+    if (m_depth > 0 && Accept(mark))
+      Fail(mark);
+    m_depth++;
+  }
+  virtual void OnSequenceEnd() { m_depth--; }
+
+  virtual void OnMapStart(const Mark& mark, const std::string&, anchor_t,
+                          EmitterStyle::value) {
+    if (Accept(mark))
+      Fail(mark);
+    m_depth++;
+  }
+  virtual void OnMapEnd() { m_depth--; }
+
+ private:
+  // whether this (inside the top sequence, or the document itself) is an
+  // element we still want
+  bool Accept(const Mark& mark) {
+    if (m_failed || m_depth > 1)
+      return false;
+    if (m_depth == 0) {
+      Fail(mark);
+      return false;
+    }
+    return true;
+  }
+
+  void Fail(const Mark& mark) {
+    m_failed = true;
+    m_failedMark = mark;
+  }
+
+ private:
+  std::vector<T>& m_values;
+  std::vector<std::size_t> m_anchors;  // 1 + the index of each anchor
+  int m_depth;
+  bool m_failed;
+  Mark m_failedMark;
+};
+}
+
+#endif  // SEQUENCEREADER_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -7,6 +7,7 @@
 #pragma once
 #endif
 
+#include <cstddef>
 #include <vector>
 #include <list>
 #include <set>
@@ -22,6 +23,27 @@ inline Emitter& EmitSeq(Emitter& emitter, const Seq& seq) {
   return emitter;
 }
 
+// contiguous values (a std::vector, an array, or a pointer and a size) are
+// written with Emitter::WriteSeq, which writes numbers in one go
+template <typename T>
+inline Emitter& EmitSeq(Emitter& emitter, const std::vector<T>& v) {
+  return emitter.WriteSeq(v.empty() ? 0 : &v[0], v.size());
+}
+
+inline Emitter& EmitSeq(Emitter& emitter, const std::vector<bool>& v) {
+  return EmitSeq<std::vector<bool> >(emitter, v);
+}
+
+template <typename T, std::size_t N>
+inline Emitter& EmitSeq(Emitter& emitter, const T (&values)[N]) {
+  return emitter.WriteSeq(values, N);
+}
+
+template <typename T>
+inline Emitter& EmitSeq(Emitter& emitter, const T* values, std::size_t size) {
+  return emitter.WriteSeq(values, size);
+}
+
 template <typename T>
 inline Emitter& operator<<(Emitter& emitter, const std::vector<T>& v) {
   return EmitSeq(emitter, v);
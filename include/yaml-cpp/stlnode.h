@@ -11,6 +11,51 @@
 #include <map>
 
 namespace YAML {
+// TryDecode
+// . Reads the same as operator >>, but without throwing, so Node::Read (and
+//   lookups by these keys) doesn't have to catch anything.
+template <typename T>
+bool TryDecode(const Node& node, std::vector<T>& v) {
+  switch (node.Type()) {
+    case NodeType::Null:
+    case NodeType::Scalar:
+      v.clear();
+      return true;
+    case NodeType::Sequence:
+      return node.ReadSequence(v);
+    case NodeType::Map:
+      break;
+  }
+
+  // a map reads by its (integer) keys 0 through size - 1
+  v.clear();
+  v.resize(node.size());
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    const Node* pValue = node.FindValue(i);
+    if (!pValue || !pValue->Read(v[i]))
+      return false;
+  }
+  return true;
+}
+
+template <typename K, typename V>
+bool TryDecode(const Node& node, std::map<K, V>& m) {
+  // as with operator >>, an empty sequence (or a null or scalar) reads as
+  // an empty map
+  m.clear();
+  if (node.Type() == NodeType::Sequence && node.size() > 0)
+    return false;
+
+  for (Iterator it = node.begin(); it != node.end(); ++it) {
+    K k;
+    V v;
+    if (!it.first().Read(k) || !it.second().Read(v))
+      return false;
+    m[k] = v;
+  }
+  return true;
+}
+
 template <typename T>
 void operator>>(const Node& node, std::vector<T>& v) {
   v.clear();
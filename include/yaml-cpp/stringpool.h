@@ -0,0 +1,54 @@
+#ifndef STRINGPOOL_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define STRINGPOOL_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "yaml-cpp/dll.h"
+#include "yaml-cpp/noncopyable.h"
+
+namespace YAML {
+// StringPool
+// . Deduplicates scalar and tag storage for the nodes a Parser builds.
+// . Nodes built with a pool refer to its strings, so the pool must outlive
+//   them (and any clones of them).
+// . It's an open-addressed hash table over the strings, which sit in a deque
+//   so they never move.
+class YAML_CPP_API StringPool : private noncopyable {
+ public:
+  StringPool();
+  ~StringPool();
+
+  const std::string& Intern(const std::string& str);
+
+  std::size_t size() const { return m_strings.size(); }
+  std::size_t lookups() const { return m_lookups; }
+  std::size_t hits() const { return m_hits; }
+
+ private:
+  struct Slot {
+    Slot() : pString(0), hash(0) {}
+
+    const std::string* pString;
+    std::size_t hash;
+  };
+
+  void Grow();
+
+ private:
+  std::deque<std::string> m_strings;
+  std::vector<Slot> m_slots;  // a power of two, at most half full
+  std::size_t m_lookups;
+  std::size_t m_hits;
+};
+}
+
+#endif  // STRINGPOOL_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -0,0 +1,319 @@
+#ifndef STRUCTDECODER_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define STRUCTDECODER_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "yaml-cpp/anchor.h"
+#include "yaml-cpp/conversion.h"
+#include "yaml-cpp/dll.h"
+#include "yaml-cpp/emitterstyle.h"
+#include "yaml-cpp/eventhandler.h"
+#include "yaml-cpp/mark.h"
+#include "yaml-cpp/noncopyable.h"
+#include "yaml-cpp/scalarhint.h"
+
+// Decoding straight into structs
+// . Describe a struct's fields once (at global scope):
+//     YAML_BEGIN_FIELDS(Config)
+//       YAML_FIELD(name)
+//       YAML_FIELD(port)
+//     YAML_END_FIELDS()
+//   or, equivalently, specialize YAML::struct_fields<Config> yourself.
+// . Then decode a document into it as it's parsed, without building a Node:
+//     Config config;
+//     YAML::StructDecoder<Config> decoder(config);
+//     parser.HandleNextDocument(decoder);
+// . Fields may be scalars, described structs, or std::vectors of either.
+//   Keys the struct doesn't describe are skipped, and fields the document
+//   doesn't mention are left alone.
+#define YAML_BEGIN_FIELDS(Type)                            \
+  namespace YAML {                                         \
+  template <>                                              \
+  struct struct_fields<Type> {                             \
+    typedef Type struct_type;                              \
+    static void Describe(FieldList<struct_type>& fields) { \
+    fields
+
+#define YAML_FIELD(member) (#member, &struct_type::member)
+
+#define YAML_END_FIELDS() \
+  ;                       \
+  }                       \
+  };                      \
+  }
+
+namespace YAML {
+class FieldDecoder;
+
+// TypeDecoder
+// . Decodes one C++ type from events; there's one (static) instance per type,
+//   and it's given a pointer to the object to decode into.
+class YAML_CPP_API TypeDecoder : private noncopyable {
+ public:
+  struct Kind {
+    enum value { Scalar, Struct, Sequence };
+  };
+
+  virtual ~TypeDecoder() {}
+  virtual Kind::value kind() const = 0;
+
+  // for scalars
+  virtual bool DecodeScalar(void* /*object*/, const std::string& /*value*/,
+                            ScalarHint::value /*hint*/) const {
+    return false;
+  }
+
+  // for structs
+  virtual const FieldDecoder* FindField(const std::string& /*key*/) const {
+    return 0;
+  }
+
+  // for sequences
+  virtual void Clear(void* /*object*/) const {}
+  virtual void* Append(void* /*object*/,
+                       const TypeDecoder*& /*elementDecoder*/) const {
+    return 0;
+  }
+};
+
+template <typename T>
+const TypeDecoder& GetTypeDecoder();
+
+// FieldDecoder
+// . One field of a struct: its key, and how to find and decode its member.
+class YAML_CPP_API FieldDecoder : private noncopyable {
+ public:
+  FieldDecoder(const char* name_, const TypeDecoder& decoder_)
+      : name(name_), decoder(decoder_) {}
+  virtual ~FieldDecoder() {}
+
+  virtual void* Member(void* object) const = 0;
+
+  const std::string name;
+  const TypeDecoder& decoder;
+};
+
+template <typename S, typename M>
+class MemberDecoder : public FieldDecoder {
+ public:
+  MemberDecoder(const char* name_, M S::*member)
+      : FieldDecoder(name_, GetTypeDecoder<M>()), m_member(member) {}
+
+  virtual void* Member(void* object) const {
+    return &(static_cast<S*>(object)->*m_member);
+  }
+
+ private:
+  M S::*m_member;
+};
+
+// StructTypeDecoder
+// . Finds fields through a perfect hash of their names, built once.
+class YAML_CPP_API StructTypeDecoder : public TypeDecoder {
+ public:
+  StructTypeDecoder();
+  virtual ~StructTypeDecoder();
+
+  virtual Kind::value kind() const { return Kind::Struct; }
+  virtual const FieldDecoder* FindField(const std::string& key) const;
+
+  void Add(FieldDecoder* pField);
+  void Finish();
+
+ private:
+  bool BuildTable(std::size_t size, unsigned seed);
+
+ private:
+  std::vector<FieldDecoder*> m_fields;  // owned
+  std::vector<const FieldDecoder*> m_table;
+  unsigned m_seed;
+};
+
+// FieldList
+// . What a struct_fields<S>::Describe() adds its fields to:
+//     fields("name", &Config::name)("port", &Config::port);
+template <typename S>
+class FieldList {
+ public:
+  explicit FieldList(StructTypeDecoder& decoder) : m_decoder(decoder) {}
+
+  template <typename M>
+  FieldList& operator()(const char* name, M S::*member) {
+    m_decoder.Add(new MemberDecoder<S, M>(name, member));
+    return *this;
+  }
+
+ private:
+  StructTypeDecoder& m_decoder;
+};
+
+// specialize this (or use YAML_BEGIN_FIELDS) to describe a struct
+template <typename S>
+struct struct_fields;
+
+template <typename S>
+class StructTypeDecoderOf : public StructTypeDecoder {
+ public:
+  StructTypeDecoderOf() {
+    FieldList<S> fields(*this);
+    struct_fields<S>::Describe(fields);
+    Finish();
+  }
+};
+
+template <typename T>
+class ScalarTypeDecoder : public TypeDecoder {
+ public:
+  virtual Kind::value kind() const { return Kind::Scalar; }
+  virtual bool DecodeScalar(void* object, const std::string& value,
+                            ScalarHint::value hint) const {
+    T& output = *static_cast<T*>(object);
+    return CanConvert(hint, output) && Convert(value, output);
+  }
+};
+
+template <typename T>
+class SequenceTypeDecoder : public TypeDecoder {
+ public:
+  virtual Kind::value kind() const { return Kind::Sequence; }
+  virtual void Clear(void* object) const {
+    static_cast<std::vector<T>*>(object)->clear();
+  }
+  virtual void* Append(void* object,
+                       const TypeDecoder*& elementDecoder) const {
+    std::vector<T>& values = *static_cast<std::vector<T>*>(object);
+    values.push_back(T());
+    elementDecoder = &GetTypeDecoder<T>();
+    return &values.back();
+  }
+};
+
+// std::vector<bool> has no bools to point to, so its elements decode
+// through the vector itself, appending as they go
+class BoolElementTypeDecoder : public TypeDecoder {
+ public:
+  virtual Kind::value kind() const { return Kind::Scalar; }
+  virtual bool DecodeScalar(void* object, const std::string& value,
+                            ScalarHint::value hint) const {
+    bool output = false;
+    if (!CanConvert(hint, output) || !Convert(value, output))
+      return false;
+    static_cast<std::vector<bool>*>(object)->push_back(output);
+    return true;
+  }
+};
+
+template <>
+class SequenceTypeDecoder<bool> : public TypeDecoder {
+ public:
+  virtual Kind::value kind() const { return Kind::Sequence; }
+  virtual void Clear(void* object) const {
+    static_cast<std::vector<bool>*>(object)->clear();
+  }
+  virtual void* Append(void* object,
+                       const TypeDecoder*& elementDecoder) const {
+    static const BoolElementTypeDecoder decoder;
+    elementDecoder = &decoder;
+    return object;
+  }
+};
+
+template <typename T, bool = is_scalar_convertible<T>::value>
+struct type_decoder {
+  typedef StructTypeDecoderOf<T> type;
+};
+
+template <typename T>
+struct type_decoder<T, true> {
+  typedef ScalarTypeDecoder<T> type;
+};
+
+template <typename T>
+struct type_decoder<std::vector<T>, false> {
+  typedef SequenceTypeDecoder<T> type;
+};
+
+template <typename T>
+inline const TypeDecoder& GetTypeDecoder() {
+  static typename type_decoder<T>::type decoder;
+  return decoder;
+}
+
+// StructDecoderBase
+// . Follows the events, decoding each node into whatever its place in the
+//   document says it belongs to.
+class YAML_CPP_API StructDecoderBase : public EventHandler,
+                                       private noncopyable {
+ public:
+  StructDecoderBase(void* pRoot, const TypeDecoder& rootDecoder);
+  virtual ~StructDecoderBase();
+
+  bool failed() const { return m_failed; }
+  const Mark& failedMark() const { return m_failedMark; }
+
+  virtual void OnDocumentStart(const Mark& mark);
+  virtual void OnDocumentEnd();
+
+  virtual void OnNull(const Mark& mark, anchor_t anchor);
+  virtual void OnAlias(const Mark& mark, anchor_t anchor);
+  virtual void OnScalar(const Mark& mark, const std::string& tag,
+                        anchor_t anchor, const std::string& value);
+  virtual void OnScalarWithHint(const Mark& mark, const std::string& tag,
+                                anchor_t anchor, const std::string& value,
+                                ScalarHint::value hint);
+
+  virtual void OnSequenceStart(const Mark& mark, const std::string& tag,
+                               anchor_t anchor, EmitterStyle::value style);
+  virtual void OnSequenceEnd();
+
+  virtual void OnMapStart(const Mark& mark, const std::string& tag,
+                          anchor_t anchor, EmitterStyle::value style);
+  virtual void OnMapEnd();
+
+ private:
+  struct Target {
+    Target() : pObject(0), pDecoder(0) {}
+    Target(void* pObject_, const TypeDecoder* pDecoder_)
+        : pObject(pObject_), pDecoder(pDecoder_) {}
+
+    void* pObject;
+    const TypeDecoder* pDecoder;  // null if we're skipping the node
+  };
+
+  struct Frame {
+    Target target;
+    bool atKey;  // for structs
+  };
+
+  bool AtKey() const;
+  Target NextTarget();
+  void BeginCollection(const Mark& mark, TypeDecoder::Kind::value kind);
+  void EndCollection();
+  void Fail(const Mark& mark);
+
+ private:
+  Target m_root;
+  Target m_value;  // for the value after a struct's key
+  std::vector<Frame> m_frames;
+  int m_skipDepth;
+  bool m_failed;
+  Mark m_failedMark;
+};
+
+template <typename S>
+class StructDecoder : public StructDecoderBase {
+ public:
+  explicit StructDecoder(S& object)
+      : StructDecoderBase(&object, GetTypeDecoder<S>()) {}
+};
+}
+
+#endif  // STRUCTDECODER_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -0,0 +1,62 @@
+#ifndef TRANSCODE_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define TRANSCODE_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <cstddef>
+#include <iosfwd>
+
+#include "yaml-cpp/dll.h"
+#include "yaml-cpp/emittermanip.h"
+#include "yaml-cpp/emitterstyle.h"
+
+namespace YAML {
+class Emitter;
+class JsonEmitter;
+
+// TranscodeOptions
+// . How Transcode reformats what it reads.
+// . stringFormat is for strings only: plain scalars that read as numbers,
+//   bools or null stay plain, so they keep their type.
+struct YAML_CPP_API TranscodeOptions {
+  TranscodeOptions()
+      : style(EmitterStyle::Default),
+        indent(2),
+        stringFormat(Auto),
+        json(false) {}
+
+  EmitterStyle::value style;   // for every collection (Default keeps each's)
+  std::size_t indent;          // for block collections
+  EMITTER_MANIP stringFormat;  // Auto, SingleQuoted, DoubleQuoted or Literal
+  bool json;                   // write JSON instead (the rest is ignored)
+};
+
+// Transcode
+// . Reads every document from 'input' and emits it again, reformatted,
+//   passing the parser's events straight to the emitter; no Node is built,
+//   so memory depends on how deeply the documents nest, not on their size.
+// . Writing to a stream (or an Emitter on a stream or sink), the output goes
+//   out in blocks as it's produced.
+// . Returns the number of documents; throws a ParserException on bad input,
+//   or an EmitterException if the emitter rejects what it's given.
+YAML_CPP_API std::size_t Transcode(
+    std::istream& input, std::ostream& output,
+    const TranscodeOptions& options = TranscodeOptions());
+YAML_CPP_API std::size_t Transcode(
+    std::istream& input, Emitter& emitter,
+    const TranscodeOptions& options = TranscodeOptions());
+
+// Transcode
+// . Converts every document from 'input' to JSON, one line each, streaming
+//   as above. Plain scalars keep the type they read as (numbers, true/false
+//   and null aren't quoted); everything else is a string, and tags are
+//   dropped. An alias repeats the node it names, so anchored nodes are kept
+//   until the end of their document.
+YAML_CPP_API std::size_t Transcode(std::istream& input, JsonEmitter& emitter);
+}
+
+#endif  // TRANSCODE_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -11,10 +11,16 @@
 #include "yaml-cpp/emitter.h"
 #include "yaml-cpp/emitterstyle.h"
 #include "yaml-cpp/stlemitter.h"
+#include "yaml-cpp/transcode.h"
 #include "yaml-cpp/exceptions.h"
+#include "yaml-cpp/jsonemitter.h"
 
 #include "yaml-cpp/node.h"
 #include "yaml-cpp/stlnode.h"
 #include "yaml-cpp/iterator.h"
+#include "yaml-cpp/outputsink.h"
+#include "yaml-cpp/sequencereader.h"
+#include "yaml-cpp/stringpool.h"
+#include "yaml-cpp/structdecoder.h"
 
 #endif  // YAML_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -2,19 +2,42 @@
 #include <sstream>
 
 #include "yaml-cpp/aliasmanager.h"
+#include "yaml-cpp/node.h"
 
 namespace YAML {
 AliasManager::AliasManager() : m_curAnchor(0) {}
 
+// RegisterReference
+// . Only aliased nodes can be referenced again, so only they get an anchor.
 void AliasManager::RegisterReference(const Node& node) {
-  m_anchorByIdentity.insert(std::make_pair(&node, _CreateNewAnchor()));
+  const anchor_t alias = node.m_aliasAnchor;
+  if (alias == NullAnchor)
+    return;
+
+  if (alias >= m_anchorByAlias.size())
+    m_anchorByAlias.resize(alias + 1);
+  Entry& entry = m_anchorByAlias[alias];
+  if (!entry.pNode) {
+    entry.pNode = &node;
+    entry.anchor = _CreateNewAnchor();
+  } else if (entry.pNode != &node &&
+             m_otherAnchors.find(&node) == m_otherAnchors.end()) {
+    m_otherAnchors[&node] = _CreateNewAnchor();
+  }
 }
 
 anchor_t AliasManager::LookupAnchor(const Node& node) const {
-  AnchorByIdentity::const_iterator it = m_anchorByIdentity.find(&node);
-  if (it == m_anchorByIdentity.end())
-    return 0;
-  return it->second;
+  const anchor_t alias = node.m_aliasAnchor;
+  if (alias >= m_anchorByAlias.size())
+    return NullAnchor;
+  const Entry& entry = m_anchorByAlias[alias];
+  if (entry.pNode == &node)
+    return entry.anchor;
+  if (m_otherAnchors.empty())
+    return NullAnchor;
+
+  AnchorByIdentity::const_iterator it = m_otherAnchors.find(&node);
+  return it == m_otherAnchors.end() ? NullAnchor : it->second;
 }
 
 anchor_t AliasManager::_CreateNewAnchor() { return ++m_curAnchor; }
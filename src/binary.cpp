@@ -1,31 +1,165 @@
 #include "yaml-cpp/binary.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "yaml-cpp/node.h"
 
+// the SIMD kernels are compiled for their instruction sets function by
+// function, and only run if the CPU has them
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#define YAML_CPP_BASE64_X86
+#include <immintrin.h>
+#endif
+
 namespace YAML {
 static const char encoding[] =
     "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-std::string EncodeBase64(const unsigned char* data, std::size_t size) {
-  const char PAD = '=';
+namespace {
+// the two characters for every 12 bits, so a group of three bytes takes two
+// lookups instead of four
+struct EncodingPairs {
+  EncodingPairs() {
+    for (unsigned i = 0; i < 4096; i++) {
+      pairs[i][0] = encoding[i >> 6];
+      pairs[i][1] = encoding[i & 0x3f];
+    }
+  }
 
-  std::string ret;
-  ret.resize(4 * size / 3 + 3);
-  char* out = &ret[0];
+  char pairs[4096][2];
+};
+
+const EncodingPairs& GetEncodingPairs() {
+  static const EncodingPairs encodingPairs;
+  return encodingPairs;
+}
+
+Base64Kernel::value BestKernel() {
+#ifdef YAML_CPP_BASE64_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return Base64Kernel::Avx2;
+  if (__builtin_cpu_supports("ssse3"))
+    return Base64Kernel::Ssse3;
+#endif
+  return Base64Kernel::Tables;
+}
 
-  std::size_t chunks = size / 3;
-  std::size_t remainder = size % 3;
+Base64Kernel::value& CurrentKernel() {
+  static Base64Kernel::value kernel = BestKernel();
+  return kernel;
+}
 
-  for (std::size_t i = 0; i < chunks; i++, data += 3) {
-    *out++ = encoding[data[0] >> 2];
-    *out++ = encoding[((data[0] & 0x3) << 4) | (data[1] >> 4)];
-    *out++ = encoding[((data[1] & 0xf) << 2) | (data[2] >> 6)];
-    *out++ = encoding[data[2] & 0x3f];
+// encodes 'groups' whole groups of three bytes; returns the end of the output
+char* EncodeGroupsWithTables(const unsigned char* data, std::size_t groups,
+                             char* out) {
+  const EncodingPairs& encodingPairs = GetEncodingPairs();
+  for (std::size_t i = 0; i < groups; i++, data += 3, out += 4) {
+    const unsigned value = (data[0] << 16) | (data[1] << 8) | data[2];
+    std::memcpy(out, encodingPairs.pairs[value >> 12], 2);
+    std::memcpy(out + 2, encodingPairs.pairs[value & 0xfff], 2);
   }
+  return out;
+}
 
-  switch (remainder) {
-    case 0:
-      break;
+#ifdef YAML_CPP_BASE64_X86
+// The SIMD encoders (after Wojciech Muła's) take four groups per 16 bytes:
+// a shuffle puts each group's bytes in a 32-bit lane, two multiplies shift
+// its four 6-bit values into separate bytes, and a second shuffle looks up
+// the offset from each value to its character, by which range it's in.
+
+__attribute__((target("ssse3"))) __m128i EncodeLanes(__m128i in) {
+  in = _mm_shuffle_epi8(
+      in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  const __m128i high = _mm_mulhi_epu16(
+      _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)),
+      _mm_set1_epi32(0x04000040));
+  const __m128i low = _mm_mullo_epi16(
+      _mm_and_si128(in, _mm_set1_epi32(0x003f03f0)),
+      _mm_set1_epi32(0x01000010));
+  const __m128i values = _mm_or_si128(high, low);
+
+  // 0 for A-Z, 1 for a-z, 2-11 for 0-9, 12 for +, 13 for /
+  __m128i range = _mm_subs_epu8(values, _mm_set1_epi8(51));
+  range = _mm_or_si128(
+      range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), values),
+                           _mm_set1_epi8(13)));
+  const __m128i offsets = _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  return _mm_add_epi8(values, _mm_shuffle_epi8(offsets, range));
+}
+
+__attribute__((target("ssse3"))) char* EncodeGroupsSsse3(
+    const unsigned char* data, std::size_t groups, char* out) {
+  // each load reads 16 bytes, for the 12 it uses
+  for (; groups >= 6; groups -= 4, data += 12, out += 16) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), EncodeLanes(in));
+  }
+  return EncodeGroupsWithTables(data, groups, out);
+}
+
+__attribute__((target("avx2"))) char* EncodeGroupsAvx2(
+    const unsigned char* data, std::size_t groups, char* out) {
+  // the same, with the second 12 bytes in the upper half
+  for (; groups >= 10; groups -= 8, data += 24, out += 32) {
+    const __m128i first =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    const __m128i second =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 12));
+    __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(first),
+                                         second, 1);
+    in = _mm256_shuffle_epi8(
+        in, _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                             1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11,
+                             10));
+    const __m256i high = _mm256_mulhi_epu16(
+        _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00)),
+        _mm256_set1_epi32(0x04000040));
+    const __m256i low = _mm256_mullo_epi16(
+        _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0)),
+        _mm256_set1_epi32(0x01000010));
+    const __m256i values = _mm256_or_si256(high, low);
+
+    __m256i range = _mm256_subs_epu8(values, _mm256_set1_epi8(51));
+    range = _mm256_or_si256(
+        range, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), values),
+                                _mm256_set1_epi8(13)));
+    const __m256i offsets = _mm256_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(out),
+        _mm256_add_epi8(values, _mm256_shuffle_epi8(offsets, range)));
+  }
+  return EncodeGroupsSsse3(data, groups, out);
+}
+#endif
+
+char* EncodeGroups(const unsigned char* data, std::size_t groups, char* out) {
+  switch (CurrentKernel()) {
+#ifdef YAML_CPP_BASE64_X86
+    case Base64Kernel::Avx2:
+      return EncodeGroupsAvx2(data, groups, out);
+    case Base64Kernel::Ssse3:
+      return EncodeGroupsSsse3(data, groups, out);
+#endif
+    default:
+      return EncodeGroupsWithTables(data, groups, out);
+  }
+}
+
+// encodes the last one or two bytes, padded
+char* EncodeTail(const unsigned char* data, std::size_t size, char* out) {
+  const char PAD = '=';
+
+  switch (size) {
     case 1:
       *out++ = encoding[data[0] >> 2];
       *out++ = encoding[((data[0] & 0x3) << 4)];
@@ -39,17 +173,63 @@ std::string EncodeBase64(const unsigned char* data, std::size_t size) {
       *out++ = PAD;
       break;
   }
+  return out;
+}
+}
+
+std::string EncodeBase64(const unsigned char* data, std::size_t size) {
+  std::string ret;
+  ret.resize(4 * size / 3 + 3);
+  char* out = &ret[0];
+
+  out = EncodeGroups(data, size / 3, out);
+  out = EncodeTail(data + size / 3 * 3, size % 3, out);
 
   ret.resize(out - &ret[0]);
   return ret;
 }
 
+void Base64Encoder::Encode(const unsigned char* data, std::size_t size,
+                           std::string& output) {
+  if (m_heldSize + size < 3) {
+    std::copy(data, data + size, m_held + m_heldSize);
+    m_heldSize += size;
+    return;
+  }
+
+  const std::size_t start = output.size();
+  output.resize(start + (m_heldSize + size) / 3 * 4);
+  char* out = &output[start];
+
+  if (m_heldSize > 0) {
+    unsigned char group[3];
+    std::copy(m_held, m_held + m_heldSize, group);
+    const std::size_t taken = 3 - m_heldSize;
+    std::copy(data, data + taken, group + m_heldSize);
+    out = EncodeGroups(group, 1, out);
+    data += taken;
+    size -= taken;
+  }
+
+  EncodeGroups(data, size / 3, out);
+  m_heldSize = size % 3;
+  std::copy(data + size - m_heldSize, data + size, m_held);
+}
+
+void Base64Encoder::Finish(std::string& output) {
+  char tail[4];
+  output.append(tail, EncodeTail(m_held, m_heldSize, tail));
+  m_heldSize = 0;
+}
+
+// 255 for characters that aren't base64, 254 for the padding, and 253 for
+// whitespace (which is skipped)
 static const unsigned char decoding[] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 253, 253, 255, 255, 253, 255,
     255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 62,  255,
+    255, 255, 253, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 62,  255,
     255, 255, 63,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61,  255, 255,
-    255, 0,   255, 255, 255, 0,   1,   2,   3,   4,   5,   6,   7,   8,   9,
+    255, 254, 255, 255, 255, 0,   1,   2,   3,   4,   5,   6,   7,   8,   9,
     10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,  21,  22,  23,  24,
     25,  255, 255, 255, 255, 255, 255, 26,  27,  28,  29,  30,  31,  32,  33,
     34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,
@@ -65,38 +245,272 @@ static const unsigned char decoding[] = {
     255,
 };
 
+static const unsigned char PAD_VALUE = 254;
+static const unsigned char INVALID_VALUE = 255;
+static const unsigned char SPACE_VALUE = 253;
+
+namespace {
+// decodes whole groups of four base64 characters (no padding or whitespace)
+// from 'in', as far as it can; returns the end of the output
+unsigned char* DecodeGroupsWithTables(const unsigned char*& in,
+                                      const unsigned char* end,
+                                      unsigned char* out) {
+  while (end - in >= 4) {
+    const unsigned a = decoding[in[0]], b = decoding[in[1]],
+                   c = decoding[in[2]], d = decoding[in[3]];
+    if ((a | b | c | d) & 0x80)
+      break;
+    const unsigned value = (a << 18) | (b << 12) | (c << 6) | d;
+    out[0] = static_cast<unsigned char>(value >> 16);
+    out[1] = static_cast<unsigned char>(value >> 8);
+    out[2] = static_cast<unsigned char>(value);
+    in += 4;
+    out += 3;
+  }
+  return out;
+}
+
+#ifdef YAML_CPP_BASE64_X86
+// The SIMD decoders (after Muła and Lemire's) take 16 characters at a time.
+// Two shuffles look up a bit mask for each character's high and low nibble,
+// which only share a bit if it isn't base64; a third looks up the offset to
+// its value. Two multiply-adds then pack each four 6-bit values into three
+// bytes. Anything else, from the first block with whitespace, padding or a
+// bad character, is left to the tables.
+
+__attribute__((target("ssse3"))) unsigned char* DecodeGroupsSsse3(
+    const unsigned char*& in, const unsigned char* end, unsigned char* out) {
+  const __m128i lowMasks =
+      _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                    0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+  const __m128i highMasks =
+      _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10,
+                    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m128i offsets = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0,
+                                        0, 0, 0, 0, 0, 0, 0);
+  const __m128i slash = _mm_set1_epi8(0x2f);
+
+  for (; end - in >= 16; in += 16, out += 12) {
+    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    const __m128i high = _mm_and_si128(_mm_srli_epi32(chars, 4), slash);
+    const __m128i bad =
+        _mm_and_si128(_mm_shuffle_epi8(lowMasks, _mm_and_si128(chars, slash)),
+                      _mm_shuffle_epi8(highMasks, high));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(bad, _mm_setzero_si128())) != 0xffff)
+      break;
+
+    // '/' shares its high nibble with '+', so it's told apart by adding -1
+    const __m128i index = _mm_add_epi8(_mm_cmpeq_epi8(chars, slash), high);
+    chars = _mm_add_epi8(chars, _mm_shuffle_epi8(offsets, index));
+    chars = _mm_maddubs_epi16(chars, _mm_set1_epi32(0x01400140));
+    chars = _mm_madd_epi16(chars, _mm_set1_epi32(0x00011000));
+    chars = _mm_shuffle_epi8(chars, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8,
+                                                  14, 13, 12, -1, -1, -1, -1));
+    // 12 bytes, without writing past them
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), chars);
+    const int last = _mm_cvtsi128_si32(_mm_srli_si128(chars, 8));
+    std::memcpy(out + 8, &last, 4);
+  }
+  return DecodeGroupsWithTables(in, end, out);
+}
+
+__attribute__((target("avx2"))) unsigned char* DecodeGroupsAvx2(
+    const unsigned char*& in, const unsigned char* end, unsigned char* out) {
+  const __m256i lowMasks = _mm256_setr_epi8(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a,
+      0x1b, 0x1b, 0x1b, 0x1a, 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+  const __m256i highMasks = _mm256_setr_epi8(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m256i offsets = _mm256_setr_epi8(
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 19, 4,
+      -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m256i slash = _mm256_set1_epi8(0x2f);
+
+  for (; end - in >= 32; in += 32, out += 24) {
+    __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+    const __m256i high = _mm256_and_si256(_mm256_srli_epi32(chars, 4), slash);
+    if (!_mm256_testz_si256(
+            _mm256_shuffle_epi8(lowMasks, _mm256_and_si256(chars, slash)),
+            _mm256_shuffle_epi8(highMasks, high)))
+      break;
+
+    const __m256i index =
+        _mm256_add_epi8(_mm256_cmpeq_epi8(chars, slash), high);
+    chars = _mm256_add_epi8(chars, _mm256_shuffle_epi8(offsets, index));
+    chars = _mm256_maddubs_epi16(chars, _mm256_set1_epi32(0x01400140));
+    chars = _mm256_madd_epi16(chars, _mm256_set1_epi32(0x00011000));
+    chars = _mm256_shuffle_epi8(
+        chars, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1,
+                                -1, -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12,
+                                -1, -1, -1, -1));
+    // 12 bytes from each half
+    const __m128i first = _mm256_castsi256_si128(chars);
+    const __m128i second = _mm256_extracti128_si256(chars, 1);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), first);
+    int last = _mm_cvtsi128_si32(_mm_srli_si128(first, 8));
+    std::memcpy(out + 8, &last, 4);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 12), second);
+    last = _mm_cvtsi128_si32(_mm_srli_si128(second, 8));
+    std::memcpy(out + 20, &last, 4);
+  }
+  return DecodeGroupsSsse3(in, end, out);
+}
+#endif
+
+unsigned char* DecodeGroups(const unsigned char*& in, const unsigned char* end,
+                            unsigned char* out) {
+  switch (CurrentKernel()) {
+#ifdef YAML_CPP_BASE64_X86
+    case Base64Kernel::Avx2:
+      return DecodeGroupsAvx2(in, end, out);
+    case Base64Kernel::Ssse3:
+      return DecodeGroupsSsse3(in, end, out);
+#endif
+    default:
+      return DecodeGroupsWithTables(in, end, out);
+  }
+}
+}
+
+Base64Kernel::value GetBase64Kernel() { return CurrentKernel(); }
+
+bool SetBase64Kernel(Base64Kernel::value kernel) {
+  switch (kernel) {
+    case Base64Kernel::Tables:
+      break;
+#ifdef YAML_CPP_BASE64_X86
+    case Base64Kernel::Ssse3:
+      if (!__builtin_cpu_supports("ssse3"))
+        return false;
+      break;
+    case Base64Kernel::Avx2:
+      if (!__builtin_cpu_supports("avx2"))
+        return false;
+      break;
+#endif
+    default:
+      return false;
+  }
+  CurrentKernel() = kernel;
+  return true;
+}
+
+void Base64Decoder::Reset() {
+  m_value = 0;
+  m_count = 0;
+  m_lastWasPad = false;
+  m_failed = false;
+}
+
+std::size_t Base64Decoder::Decode(const char* data, std::size_t size,
+                                  unsigned char* output) {
+  if (m_failed)
+    return 0;
+
+  unsigned char* out = output;
+  const unsigned char* in = reinterpret_cast<const unsigned char*>(data);
+  const unsigned char* end = in + size;
+  while (in < end) {
+    // whole groups of four without padding go straight through
+    if (m_count == 0) {
+      out = DecodeGroups(in, end, out);
+      if (in == end)
+        break;
+    }
+
+    // anything else, a character at a time (padding counts as zero bits,
+    // and drops the bytes it ends)
+    const unsigned char d = decoding[*in++];
+    if (d == SPACE_VALUE)
+      continue;
+    if (d == INVALID_VALUE) {
+      m_failed = true;
+      return 0;
+    }
+
+    const bool pad = d == PAD_VALUE;
+    m_value = (m_value << 6) | (pad ? 0 : d);
+    if (++m_count == 4) {
+      *out++ = static_cast<unsigned char>(m_value >> 16);
+      if (!m_lastWasPad)
+        *out++ = static_cast<unsigned char>(m_value >> 8);
+      if (!pad)
+        *out++ = static_cast<unsigned char>(m_value);
+      m_value = 0;
+      m_count = 0;
+    }
+    m_lastWasPad = pad;
+  }
+
+  return out - output;
+}
+
+bool Base64Decoder::Decode(const char* data, std::size_t size,
+                           std::vector<unsigned char>& output) {
+  const std::size_t start = output.size();
+  output.resize(start + MaxDecodedSize(size));
+  const std::size_t written =
+      Decode(data, size, output.empty() ? 0 : &output[0] + start);
+  output.resize(start + written);
+  return !m_failed;
+}
+
 std::vector<unsigned char> DecodeBase64(const std::string& input) {
   typedef std::vector<unsigned char> ret_type;
-  if (input.empty())
+
+  ret_type ret;
+  Base64Decoder decoder;
+  if (!decoder.Decode(input.data(), input.size(), ret))
     return ret_type();
+  return ret;
+}
+
+bool DecodeBinary(const Node& node, unsigned char* buffer,
+                  std::size_t capacity, std::size_t& size) {
+  size = 0;
+  const char* scalar = 0;
+  std::size_t length = 0;
+  if (!node.GetScalar(scalar, length))
+    return false;
 
-  ret_type ret(3 * input.size() / 4 + 1);
-  unsigned char* out = &ret[0];
-
-  unsigned value = 0;
-  for (std::size_t i = 0; i < input.size(); i++) {
-    unsigned char d = decoding[static_cast<unsigned>(input[i])];
-    if (d == 255)
-      return ret_type();
-
-    value = (value << 6) | d;
-    if (i % 4 == 3) {
-      *out++ = value >> 16;
-      if (i > 0 && input[i - 1] != '=')
-        *out++ = value >> 8;
-      if (input[i] != '=')
-        *out++ = value;
+  Base64Decoder decoder;
+  while (length > 0) {
+    // as much as certainly fits, straight into the buffer; and near the end,
+    // a group at a time, to see if it does
+    std::size_t chunk = (capacity - size) / 3 * 4;
+    if (chunk > 0) {
+      chunk = std::min(chunk, length);
+      size += decoder.Decode(scalar, chunk, buffer + size);
+    } else {
+      unsigned char group[3];
+      chunk = std::min<std::size_t>(4, length);
+      const std::size_t written = decoder.Decode(scalar, chunk, group);
+      if (written > capacity - size)
+        return false;
+      std::copy(group, group + written, buffer + size);
+      size += written;
     }
+    if (decoder.failed())
+      return false;
+    scalar += chunk;
+    length -= chunk;
   }
-
-  ret.resize(out - &ret[0]);
-  return ret;
+  return true;
 }
 
 void operator>>(const Node& node, Binary& binary) {
-  std::string scalar;
-  node.GetScalar(scalar);
-  std::vector<unsigned char> data = DecodeBase64(scalar);
+  // decoded from the node's own scalar, without a copy of it
+  const char* scalar = 0;
+  std::size_t size = 0;
+  std::vector<unsigned char> data;
+  if (node.GetScalar(scalar, size)) {
+    Base64Decoder decoder;
+    if (!decoder.Decode(scalar, size, data))
+      data.clear();
+  }
   binary.swap(data);
 }
 }
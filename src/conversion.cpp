@@ -1,6 +1,8 @@
-#include <algorithm>
+#include <cfloat>
 
+#include "scalarclassifier.h"
 #include "yaml-cpp/conversion.h"
+#include "yaml-cpp/scalarhint.h"
 
 namespace YAML {
 struct _Null;
@@ -11,72 +13,415 @@ struct _Null;
 
 namespace {
 // we're not gonna mess with the mess that is all the isupper/etc. functions
-bool IsLower(char ch) { return 'a' <= ch && ch <= 'z'; }
-bool IsUpper(char ch) { return 'A' <= ch && ch <= 'Z'; }
-char ToLower(char ch) { return IsUpper(ch) ? ch + 'a' - 'A' : ch; }
+char ToUpper(char ch) { return 'a' <= ch && ch <= 'z' ? ch + 'A' - 'a' : ch; }
+char ToLower(char ch) { return 'A' <= ch && ch <= 'Z' ? ch + 'a' - 'A' : ch; }
 
-std::string tolower(const std::string& str) {
-  std::string s(str);
-  std::transform(s.begin(), s.end(), s.begin(), ToLower);
-  return s;
+// IsKeyword
+// . Returns true if 'str' is 'keyword' (given in lowercase, and the same
+//   length) as either:
+//   . UPPERCASE
+//   . lowercase
+//   . Capitalized
+bool IsKeyword(const char* str, const char* keyword, std::size_t size) {
+  const bool firstcaps = str[0] != keyword[0];
+  if (firstcaps && str[0] != ToUpper(keyword[0]))
+    return false;
+
+  const bool allcaps = size > 1 && str[1] != keyword[1];
+  if (allcaps && !firstcaps)
+    return false;
+
+  for (std::size_t i = 1; i < size; i++) {
+    if (str[i] != (allcaps ? ToUpper(keyword[i]) : keyword[i]))
+      return false;
+  }
+  return true;
+}
+
+// the whitespace stream extraction skips (in the classic locale)
+bool IsSpace(char ch) {
+  return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\v' || ch == '\f' ||
+         ch == '\r';
+}
+
+const char* SkipSpace(const char* it, const char* end) {
+  while (it != end && IsSpace(*it))
+    ++it;
+  return it;
+}
+
+const char* ReadSign(const char* it, const char* end, bool& negative) {
+  negative = false;
+  if (it != end && (*it == '+' || *it == '-')) {
+    negative = *it == '-';
+    ++it;
+  }
+  return it;
+}
+
+unsigned DigitValue(char ch) {
+  if ('0' <= ch && ch <= '9')
+    return ch - '0';
+  if ('a' <= ch && ch <= 'f')
+    return ch - 'a' + 10;
+  if ('A' <= ch && ch <= 'F')
+    return ch - 'A' + 10;
+  return 16;
 }
 
+// FloatTraits
+// . The largest mantissa and power of ten that are exact in T; a number
+//   within both is correctly rounded by one multiplication or division.
+// . For float we compute in double, which is wide enough that rounding
+//   twice gives the same answer.
 template <typename T>
-bool IsEntirely(const std::string& str, T func) {
-  for (std::size_t i = 0; i < str.size(); i++)
-    if (!func(str[i]))
+struct FloatTraits;
+
+template <>
+struct FloatTraits<float> {
+  static const unsigned long long maxMantissa = 1ULL << 24;
+  static const int maxExponent = 10;
+};
+
+template <>
+struct FloatTraits<double> {
+  static const unsigned long long maxMantissa = 1ULL << 53;
+  static const int maxExponent = 22;
+};
+
+const double powersOfTen[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                              1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                              1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+// with extended precision (x87) arithmetic, even one operation can round
+// twice, so we always take the slow path
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0
+const bool fastPathIsExact = false;
+#else
+const bool fastPathIsExact = true;
+#endif
+
+template <typename T>
+bool ParseFloat(const char* input, std::size_t size, T& output) {
+  const char* end = input + size;
+  bool negative = false;
+  const char* it = ReadSign(SkipSpace(input, end), end, negative);
+
+  // the significant digits go in 'mantissa', up to 19 of them (after that,
+  // it's only useful to keep checking the syntax)
+  unsigned long long mantissa = 0;
+  int digits = 0, exponent = 0;
+  bool anyDigits = false, truncated = false, fraction = false;
+  for (; it != end; ++it) {
+    if (*it == '.' && !fraction) {
+      fraction = true;
+      continue;
+    }
+    if (*it < '0' || *it > '9')
+      break;
+
+    anyDigits = true;
+    if (mantissa == 0 && *it == '0') {
+      // leading zeros aren't significant
+    } else if (digits < 19) {
+      mantissa = mantissa * 10 + (*it - '0');
+      digits++;
+    } else {
+      truncated = true;
+      continue;
+    }
+    if (fraction)
+      exponent--;
+  }
+  if (!anyDigits)
+    return false;
+
+  if (it != end && (*it == 'e' || *it == 'E')) {
+    bool negativeExponent = false;
+    it = ReadSign(it + 1, end, negativeExponent);
+    if (it == end || *it < '0' || *it > '9')
       return false;
 
-  return true;
-}
+    int explicitExponent = 0;
+    for (; it != end && '0' <= *it && *it <= '9'; ++it) {
+      if (explicitExponent < 100000)
+        explicitExponent = explicitExponent * 10 + (*it - '0');
+    }
+    exponent += negativeExponent ? -explicitExponent : explicitExponent;
+  }
 
-// IsFlexibleCase
-// . Returns true if 'str' is:
-//   . UPPERCASE
-//   . lowercase
-//   . Capitalized
-bool IsFlexibleCase(const std::string& str) {
-  if (str.empty())
-    return true;
+  if (SkipSpace(it, end) != end)
+    return false;
 
-  if (IsEntirely(str, IsLower))
+  if (mantissa == 0) {
+    output = negative ? -static_cast<T>(0) : static_cast<T>(0);
     return true;
+  }
+
+  if (!fastPathIsExact || truncated ||
+      mantissa > FloatTraits<T>::maxMantissa ||
+      exponent < -FloatTraits<T>::maxExponent ||
+      exponent > FloatTraits<T>::maxExponent)
+    return YAML::ConvertStreamable(input, size, output);
 
-  bool firstcaps = IsUpper(str[0]);
-  std::string rest = str.substr(1);
-  return firstcaps && (IsEntirely(rest, IsLower) || IsEntirely(rest, IsUpper));
+  double value = static_cast<double>(mantissa);
+  if (exponent < 0)
+    value /= powersOfTen[-exponent];
+  else
+    value *= powersOfTen[exponent];
+
+  output = static_cast<T>(negative ? -value : value);
+  return true;
 }
 }
 
 namespace YAML {
-bool Convert(const std::string& input, bool& b) {
+ScalarKeyword::value ClassifyKeyword(const char* input, std::size_t size) {
   // we can't use iostream bool extraction operators as they don't
-  // recognize all possible values in the table below (taken from
-  // http://yaml.org/type/bool.html)
-  static const struct {
-    std::string truename, falsename;
-  } names[] = {{"y", "n"}, {"yes", "no"}, {"true", "false"}, {"on", "off"}, };
+  // recognize all possible values (taken from http://yaml.org/type/bool.html)
+  // . each length and first letter leaves at most one keyword to check
+  switch (size) {
+    case 0:
+      return ScalarKeyword::Null;
+    case 1:
+      switch (input[0]) {
+        case '~':
+          return ScalarKeyword::Null;
+        case 'y':
+        case 'Y':
+          return ScalarKeyword::True;
+        case 'n':
+        case 'N':
+          return ScalarKeyword::False;
+      }
+      break;
+    case 2:
+      switch (ToLower(input[0])) {
+        case 'o':
+          return IsKeyword(input, "on", size) ? ScalarKeyword::True
+                                              : ScalarKeyword::None;
+        case 'n':
+          return IsKeyword(input, "no", size) ? ScalarKeyword::False
+                                              : ScalarKeyword::None;
+      }
+      break;
+    case 3:
+      switch (ToLower(input[0])) {
+        case 'y':
+          return IsKeyword(input, "yes", size) ? ScalarKeyword::True
+                                               : ScalarKeyword::None;
+        case 'o':
+          return IsKeyword(input, "off", size) ? ScalarKeyword::False
+                                               : ScalarKeyword::None;
+      }
+      break;
+    case 4:
+      switch (ToLower(input[0])) {
+        case 't':
+          return IsKeyword(input, "true", size) ? ScalarKeyword::True
+                                                : ScalarKeyword::None;
+        case 'n':
+          return IsKeyword(input, "null", size) ? ScalarKeyword::Null
+                                                : ScalarKeyword::None;
+      }
+      break;
+    case 5:
+      return IsKeyword(input, "false", size) ? ScalarKeyword::False
+                                             : ScalarKeyword::None;
+  }
 
-  if (!IsFlexibleCase(input))
-    return false;
+  return ScalarKeyword::None;
+}
 
-  for (unsigned i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
-    if (names[i].truename == tolower(input)) {
+bool Convert(const char* input, std::size_t size, bool& b) {
+  switch (ClassifyKeyword(input, size)) {
+    case ScalarKeyword::True:
       b = true;
       return true;
-    }
-
-    if (names[i].falsename == tolower(input)) {
+    case ScalarKeyword::False:
       b = false;
       return true;
+    case ScalarKeyword::None:
+    case ScalarKeyword::Null:
+      break;
+  }
+  return false;
+}
+
+bool ParseInteger(const char* input, std::size_t size, bool& negative,
+                  unsigned long long& magnitude) {
+  const char* end = input + size;
+  const char* it = ReadSign(SkipSpace(input, end), end, negative);
+
+  unsigned base = 10;
+  if (end - it >= 2 && it[0] == '0') {
+    if (it[1] == 'x' || it[1] == 'X') {
+      base = 16;
+      it += 2;
+    } else if (it[1] == 'o') {
+      base = 8;
+      it += 2;
+    } else {
+      base = 8;
     }
   }
 
-  return false;
+  const unsigned long long max = std::numeric_limits<unsigned long long>::max();
+  const char* digits = it;
+  magnitude = 0;
+  for (; it != end; ++it) {
+    unsigned digit = DigitValue(*it);
+    if (digit >= base)
+      break;
+    if (magnitude > (max - digit) / base)
+      return false;
+    magnitude = magnitude * base + digit;
+  }
+
+  return it != digits && SkipSpace(it, end) == end;
+}
+
+bool ParseFloatingPoint(const char* input, std::size_t size, float& output) {
+  return ParseFloat(input, size, output);
+}
+
+bool ParseFloatingPoint(const char* input, std::size_t size, double& output) {
+  return ParseFloat(input, size, output);
+}
+
+// ScalarClassifier
+// . Runs the syntax of ParseInteger and ParseFloat side by side, one
+//   character at a time.
+void ScalarClassifier::Step(char ch) {
+  const bool space = IsSpace(ch);
+  const bool sign = ch == '+' || ch == '-';
+  const bool digit = '0' <= ch && ch <= '9';
+
+  switch (m_integer) {
+    case I_START:
+    case I_SIGN:
+      if (space && m_integer == I_START)
+        break;
+      if (sign && m_integer == I_START)
+        m_integer = I_SIGN;
+      else if (ch == '0')
+        m_integer = I_ZERO;
+      else
+        m_integer = digit ? I_DIGITS : I_FAIL;
+      break;
+    case I_ZERO:
+      // a leading 0 is octal, as is 0o; 0x is hex
+      if (ch == 'x' || ch == 'X') {
+        m_base = 16;
+        m_integer = I_PREFIX;
+      } else if (ch == 'o') {
+        m_base = 8;
+        m_integer = I_PREFIX;
+      } else if (space) {
+        m_integer = I_TRAIL;
+      } else {
+        m_base = 8;
+        m_integer = DigitValue(ch) < m_base ? I_DIGITS : I_FAIL;
+      }
+      break;
+    case I_PREFIX:
+    case I_DIGITS:
+      if (DigitValue(ch) < m_base)
+        m_integer = I_DIGITS;
+      else
+        m_integer = space && m_integer == I_DIGITS ? I_TRAIL : I_FAIL;
+      break;
+    case I_TRAIL:
+      if (!space)
+        m_integer = I_FAIL;
+      break;
+    case I_FAIL:
+      break;
+  }
+
+  switch (m_float) {
+    case F_START:
+    case F_SIGN:
+      if (space && m_float == F_START)
+        break;
+      if (sign && m_float == F_START)
+        m_float = F_SIGN;
+      else if (ch == '.')
+        m_float = F_DOT;
+      else
+        m_float = digit ? F_WHOLE : F_FAIL;
+      break;
+    case F_DOT:
+      m_float = digit ? F_FRACTION : F_FAIL;
+      break;
+    case F_WHOLE:
+    case F_FRACTION:
+      if (ch == '.' && m_float == F_WHOLE)
+        m_float = F_FRACTION;
+      else if (ch == 'e' || ch == 'E')
+        m_float = F_EXPONENT_MARK;
+      else if (space)
+        m_float = F_TRAIL;
+      else if (!digit)
+        m_float = F_FAIL;
+      break;
+    case F_EXPONENT_MARK:
+      if (sign)
+        m_float = F_EXPONENT_SIGN;
+      else
+        m_float = digit ? F_EXPONENT : F_FAIL;
+      break;
+    case F_EXPONENT_SIGN:
+      m_float = digit ? F_EXPONENT : F_FAIL;
+      break;
+    case F_EXPONENT:
+      if (space)
+        m_float = F_TRAIL;
+      else if (!digit)
+        m_float = F_FAIL;
+      break;
+    case F_TRAIL:
+      if (!space)
+        m_float = F_FAIL;
+      break;
+    case F_FAIL:
+      break;
+  }
+
+  m_number = m_integer != I_FAIL || m_float != F_FAIL;
+}
+
+ScalarHint::value ScalarClassifier::Finish(const char* scalar,
+                                           std::size_t size) const {
+  switch (ClassifyKeyword(scalar, size)) {
+    case ScalarKeyword::True:
+    case ScalarKeyword::False:
+      return ScalarHint::Bool;
+    case ScalarKeyword::Null:
+      return ScalarHint::Null;
+    case ScalarKeyword::None:
+      break;
+  }
+
+  if (m_integer == I_ZERO || m_integer == I_DIGITS || m_integer == I_TRAIL)
+    return ScalarHint::Int;
+  if (m_float == F_WHOLE || m_float == F_FRACTION || m_float == F_EXPONENT ||
+      m_float == F_TRAIL)
+    return ScalarHint::Float;
+  if (IsInfinity(scalar, size) || IsNegativeInfinity(scalar, size) ||
+      IsNaN(scalar, size))
+    return ScalarHint::Float;
+  return ScalarHint::String;
+}
+
+ScalarHint::value ClassifyPlainScalar(const char* input, std::size_t size) {
+  ScalarClassifier classifier;
+  for (std::size_t i = 0; i < size; i++)
+    classifier.Add(input[i]);
+  return classifier.Finish(input, size);
 }
 
-bool Convert(const std::string& input, _Null& /*output*/) {
-  return input.empty() || input == "~" || input == "null" || input == "Null" ||
-         input == "NULL";
+bool Convert(const char* input, std::size_t size, _Null& /*output*/) {
+  return ClassifyKeyword(input, size) == ScalarKeyword::Null;
 }
 }
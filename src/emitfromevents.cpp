@@ -19,7 +19,11 @@ std::string ToString(YAML::anchor_t anchor) {
 }
 
 namespace YAML {
-EmitFromEvents::EmitFromEvents(Emitter& emitter) : m_emitter(emitter) {}
+EmitFromEvents::EmitFromEvents(Emitter& emitter)
+    : m_emitter(emitter), m_style(EmitterStyle::Default) {}
+
+EmitFromEvents::EmitFromEvents(Emitter& emitter, EmitterStyle::value style)
+    : m_emitter(emitter), m_style(style) {}
 
 void EmitFromEvents::OnDocumentStart(const Mark&) {}
 
@@ -40,6 +44,9 @@ void EmitFromEvents::OnScalar(const Mark&, const std::string& tag,
                               anchor_t anchor, const std::string& value) {
   BeginNode();
   EmitProps(tag, anchor);
+  // the non-specific tag "!" (a quoted scalar) is kept by quoting it again
+  if (tag == "!")
+    m_emitter << DoubleQuoted;
   m_emitter << value;
 }
 
@@ -48,16 +55,7 @@ void EmitFromEvents::OnSequenceStart(const Mark&, const std::string& tag,
                                      EmitterStyle::value style) {
   BeginNode();
   EmitProps(tag, anchor);
-  switch (style) {
-    case EmitterStyle::Block:
-      m_emitter << Block;
-      break;
-    case EmitterStyle::Flow:
-      m_emitter << Flow;
-      break;
-    default:
-      break;
-  }
+  EmitStyle(style);
   m_emitter << BeginSeq;
   m_stateStack.push(State::WaitingForSequenceEntry);
 }
@@ -72,16 +70,7 @@ void EmitFromEvents::OnMapStart(const Mark&, const std::string& tag,
                                 anchor_t anchor, EmitterStyle::value style) {
   BeginNode();
   EmitProps(tag, anchor);
-  switch (style) {
-    case EmitterStyle::Block:
-      m_emitter << Block;
-      break;
-    case EmitterStyle::Flow:
-      m_emitter << Flow;
-      break;
-    default:
-      break;
-  }
+  EmitStyle(style);
   m_emitter << BeginMap;
   m_stateStack.push(State::WaitingForKey);
 }
@@ -110,8 +99,24 @@ void EmitFromEvents::BeginNode() {
   }
 }
 
+void EmitFromEvents::EmitStyle(EmitterStyle::value style) {
+  if (m_style != EmitterStyle::Default)
+    style = m_style;
+
+  switch (style) {
+    case EmitterStyle::Block:
+      m_emitter << Block;
+      break;
+    case EmitterStyle::Flow:
+      m_emitter << Flow;
+      break;
+    default:
+      break;
+  }
+}
+
 void EmitFromEvents::EmitProps(const std::string& tag, anchor_t anchor) {
-  if (!tag.empty() && tag != "?")
+  if (!tag.empty() && tag != "?" && tag != "!")
     m_emitter << VerbatimTag(tag);
   if (anchor)
     m_emitter << Anchor(ToString(anchor));
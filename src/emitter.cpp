@@ -1,4 +1,6 @@
+#include <cstring>
 #include <sstream>
+#include <string>
 
 #include "emitterutils.h"
 #include "indentation.h"  // IWYU pragma: keep
@@ -9,19 +11,47 @@
 
 namespace YAML {
 class Binary;
+struct BinaryStream;
 struct _Null;
 
 Emitter::Emitter() : m_pState(new EmitterState) {}
 
+Emitter::Emitter(std::size_t reserveSize) : m_pState(new EmitterState) {
+  m_stream.reserve(reserveSize);
+}
+
 Emitter::Emitter(std::ostream& stream)
     : m_pState(new EmitterState), m_stream(stream) {}
 
+Emitter::Emitter(std::ostream& stream, std::size_t blockSize)
+    : m_pState(new EmitterState), m_stream(stream, blockSize) {}
+
+Emitter::Emitter(OutputSink& sink)
+    : m_pState(new EmitterState), m_stream(sink) {}
+
+Emitter::Emitter(OutputSink& sink, std::size_t blockSize)
+    : m_pState(new EmitterState), m_stream(sink, blockSize) {}
+
 Emitter::~Emitter() {}
 
 const char* Emitter::c_str() const { return m_stream.str(); }
 
 std::size_t Emitter::size() const { return m_stream.pos(); }
 
+void Emitter::Reserve(std::size_t size) { m_stream.reserve(size); }
+
+void Emitter::TakeOutput(std::string& output) {
+  m_pState->Reset();
+  m_stream.take(output);
+}
+
+void Emitter::Flush() { m_stream.flush(); }
+
+void Emitter::Reset() {
+  m_pState->Reset();
+  m_stream.clear();
+}
+
 // state checking
 bool Emitter::good() const { return m_pState->good(); }
 
@@ -650,23 +680,57 @@ void Emitter::SpaceOrIndentTo(bool requireSpace, std::size_t indent) {
   m_stream << IndentTo(indent);
 }
 
-void Emitter::PrepareIntegralStream(std::stringstream& stream) const {
+namespace {
+// FormatIntegralBits
+// . 'bits' is the value converted to unsigned long long; like a stream, we
+//   write a negative value in Hex or Oct as its (size-byte) two's complement.
+std::size_t FormatIntegralBits(char* output, unsigned long long bits,
+                               bool negative, std::size_t size,
+                               EMITTER_MANIP intFormat) {
+  assert(intFormat == Dec || intFormat == Hex || intFormat == Oct);
+
+  if (intFormat == Dec)
+    return Utils::FormatInteger(output, negative ? 0 - bits : bits, negative,
+                                Dec);
+
+  if (size < sizeof(bits))
+    bits &= (1ULL << (8 * size)) - 1;
+  return Utils::FormatInteger(output, bits, false, intFormat);
+}
 
-  switch (m_pState->GetIntFormat()) {
-    case Dec:
-      stream << std::dec;
-      break;
-    case Hex:
-      stream << "0x";
-      stream << std::hex;
-      break;
-    case Oct:
-      stream << "0";
-      stream << std::oct;
-      break;
-    default:
-      assert(false);
-  }
+// the settings for the numbers in a sequence
+struct NumberFormat {
+  EMITTER_MANIP intFormat;
+  std::size_t floatPrecision;
+  std::size_t doublePrecision;
+};
+
+template <typename T>
+std::size_t FormatNumber(char* output, T value, const NumberFormat& format) {
+  return FormatIntegralBits(output, static_cast<unsigned long long>(value),
+                            value < T(), sizeof(T), format.intFormat);
+}
+
+std::size_t FormatNumber(char* output, float value,
+                         const NumberFormat& format) {
+  return Utils::FormatFloatingPoint(output, value, format.floatPrecision);
+}
+
+std::size_t FormatNumber(char* output, double value,
+                         const NumberFormat& format) {
+  return Utils::FormatFloatingPoint(output, value, format.doublePrecision);
+}
+}
+
+void Emitter::WriteIntegralBits(unsigned long long bits, bool negative,
+                                std::size_t size) {
+  char buffer[Utils::MaxIntegerSize];
+  m_stream.write(buffer, FormatIntegralBits(buffer, bits, negative, size,
+                                            m_pState->GetIntFormat()));
+}
+
+void Emitter::WriteFloatingPoint(double value, std::size_t precision) {
+  Utils::WriteFloatingPoint(m_stream, value, precision);
 }
 
 void Emitter::StartedScalar() { m_pState->StartedScalar(); }
@@ -908,4 +972,120 @@ Emitter& Emitter::Write(const Binary& binary) {
 
   return *this;
 }
+
+Emitter& Emitter::Write(const BinaryStream& binary) {
+  if (!good())
+    return *this;
+
+  // (a literal key has to be a long key, and it starts with the tag)
+  const bool literal = m_pState->CurGroupFlowType() != FlowType::Flow;
+  if (literal)
+    m_pState->SetMapKeyFormat(YAML::LongKey, FmtScope::Local);
+
+  Write(SecondaryTag("binary"));
+  if (!good())
+    return *this;
+
+  PrepareNode(EmitterNodeType::Scalar);
+  Utils::WriteBinary(m_stream, binary,
+                     literal ? m_pState->CurIndent() + m_pState->GetIndent()
+                             : -1);
+  StartedScalar();
+
+  return *this;
+}
+
+// *******************************************************************************************
+// sequences of numbers
+
+// WriteNumberSeq
+// . The first number goes through PrepareNode() as usual, which settles
+//   where the sequence is (and what's in effect in it). Every one after
+//   that has the same separator, so the rest are formatted into a local
+//   buffer, and written a buffer at a time.
+template <typename T>
+Emitter& Emitter::WriteNumberSeq(const T* values, std::size_t count) {
+  EmitBeginSeq();
+  if (good() && count > 0)
+    *this << values[0];
+  if (!good())
+    return *this;
+
+  std::string separator = ", ";
+  if (m_pState->CurGroupNodeType() == EmitterNodeType::BlockSeq) {
+    const std::size_t curIndent = m_pState->CurIndent();
+    const std::size_t nextIndent = curIndent + m_pState->CurGroupIndent();
+    separator = "\n" + std::string(curIndent, ' ') + "-";
+    if (nextIndent > curIndent + 1)
+      separator.append(nextIndent - curIndent - 1, ' ');
+  }
+
+  const NumberFormat format = {m_pState->GetIntFormat(), GetFloatPrecision(),
+                               GetDoublePrecision()};
+  char buffer[4096];
+  const std::size_t room = separator.size() + Utils::MaxFloatingPointSize;
+  std::size_t size = 0;
+
+  for (std::size_t i = 1; i < count; i++) {
+    if (size + room > sizeof(buffer)) {
+      m_stream.write(buffer, size);
+      size = 0;
+    }
+    if (room > sizeof(buffer)) {
+      // (only with a huge indent)
+      m_stream << separator;
+    } else {
+      std::memcpy(buffer + size, separator.data(), separator.size());
+      size += separator.size();
+    }
+    size += FormatNumber(buffer + size, values[i], format);
+  }
+  m_stream.write(buffer, size);
+
+  if (count > 1)
+    m_pState->StartedScalars(count - 1);
+  EmitEndSeq();
+  return *this;
+}
+
+Emitter& Emitter::WriteSeq(const short* values, std::size_t count) {
+  return WriteNumberSeq(values, count);
+}
+
+Emitter& Emitter::WriteSeq(const unsigned short* values, std::size_t count) {
+  return WriteNumberSeq(values, count);
+}
+
+Emitter& Emitter::WriteSeq(const int* values, std::size_t count) {
+  return WriteNumberSeq(values, count);
+}
+
+Emitter& Emitter::WriteSeq(const unsigned int* values, std::size_t count) {
+  return WriteNumberSeq(values, count);
+}
+
+Emitter& Emitter::WriteSeq(const long* values, std::size_t count) {
+  return WriteNumberSeq(values, count);
+}
+
+Emitter& Emitter::WriteSeq(const unsigned long* values, std::size_t count) {
+  return WriteNumberSeq(values, count);
+}
+
+Emitter& Emitter::WriteSeq(const long long* values, std::size_t count) {
+  return WriteNumberSeq(values, count);
+}
+
+Emitter& Emitter::WriteSeq(const unsigned long long* values,
+                           std::size_t count) {
+  return WriteNumberSeq(values, count);
+}
+
+Emitter& Emitter::WriteSeq(const float* values, std::size_t count) {
+  return WriteNumberSeq(values, count);
+}
+
+Emitter& Emitter::WriteSeq(const double* values, std::size_t count) {
+  return WriteNumberSeq(values, count);
+}
 }
@@ -11,6 +11,30 @@ EmitterState::EmitterState()
       m_hasTag(false),
       m_hasNonContent(false),
       m_docCount(0) {
+  SetDefaults();
+}
+
+EmitterState::~EmitterState() {}
+
+void EmitterState::Reset() {
+  while (!m_groups.empty()) {
+    m_groups.top().modifiedSettings.clear();
+    m_groups.pop();
+  }
+  m_modifiedSettings.clear();
+  m_globalModifiedSettings.clear();
+  SetDefaults();
+
+  m_isGood = true;
+  m_lastError.clear();
+  m_curIndent = 0;
+  m_hasAnchor = false;
+  m_hasTag = false;
+  m_hasNonContent = false;
+  m_docCount = 0;
+}
+
+void EmitterState::SetDefaults() {
   // set default global manipulators
   m_charset.set(EmitNonAscii);
   m_strFmt.set(Auto);
@@ -28,8 +52,6 @@ EmitterState::EmitterState()
   m_doublePrecision.set(std::numeric_limits<double>::digits10 + 1);
 }
 
-EmitterState::~EmitterState() {}
-
 // SetLocalValue
 // . We blindly tries to set all possible formatters to this value
 // . Only the ones that make sense will be accepted
@@ -118,25 +140,32 @@ void EmitterState::StartedScalar() {
   ClearModifiedSettings();
 }
 
+// StartedScalars
+// . For plain scalars written together after one through StartedScalar()
+//   (which cleared everything they'd otherwise clear).
+void EmitterState::StartedScalars(std::size_t count) {
+  assert(!m_groups.empty() && !m_hasAnchor && !m_hasTag);
+  m_groups.top().childCount += count;
+}
+
 void EmitterState::StartedGroup(GroupType::value type) {
   StartedNode();
 
   const int lastGroupIndent = (m_groups.empty() ? 0 : m_groups.top().indent);
   m_curIndent += lastGroupIndent;
 
-  std::auto_ptr<Group> pGroup(new Group(type));
-
-  // transfer settings (which last until this group is done)
-  pGroup->modifiedSettings = m_modifiedSettings;
+  // set up group (before pushing it, since that changes the current group)
+  const FlowType::value flowType =
+      GetFlowType(type) == Block ? FlowType::Block : FlowType::Flow;
+  const int indent = GetIndent();
 
-  // set up group
-  if (GetFlowType(type) == Block)
-    pGroup->flowType = FlowType::Block;
-  else
-    pGroup->flowType = FlowType::Flow;
-  pGroup->indent = GetIndent();
+  Group& group = m_groups.push();
+  group.Start(type);
+  group.flowType = flowType;
+  group.indent = indent;
 
-  m_groups.push(pGroup);
+  // transfer settings (which last until this group is done)
+  m_modifiedSettings.transfer(group.modifiedSettings);
 }
 
 void EmitterState::EndedGroup(GroupType::value type) {
@@ -149,8 +178,11 @@ void EmitterState::EndedGroup(GroupType::value type) {
 
   // get rid of the current group
   {
-    std::auto_ptr<Group> pFinishedGroup = m_groups.pop();
-    if (pFinishedGroup->type != type)
+    Group& finishedGroup = m_groups.top();
+    const GroupType::value finishedType = finishedGroup.type;
+    finishedGroup.modifiedSettings.clear();
+    m_groups.pop();
+    if (finishedType != type)
       return SetError(ErrorMsg::UNMATCHED_GROUP_TAG);
   }
 
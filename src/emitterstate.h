@@ -7,7 +7,7 @@
 #pragma once
 #endif
 
-#include "ptr_stack.h"
+#include "inline_stack.h"
 #include "setting.h"
 #include "yaml-cpp/emitterdef.h"
 #include "yaml-cpp/emittermanip.h"
@@ -33,6 +33,9 @@ class EmitterState {
   EmitterState();
   ~EmitterState();
 
+  // back to a new EmitterState, keeping the storage it's grown
+  void Reset();
+
   // basic state checking
   bool good() const { return m_isGood; }
   const std::string GetLastError() const { return m_lastError; }
@@ -50,6 +53,7 @@ class EmitterState {
   void StartedDoc();
   void EndedDoc();
   void StartedScalar();
+  void StartedScalars(std::size_t count);
   void StartedGroup(GroupType::value type);
   void EndedGroup(GroupType::value type);
 
@@ -119,6 +123,7 @@ class EmitterState {
   void _Set(Setting<T>& fmt, T value, FmtScope::value scope);
 
   void StartedNode();
+  void SetDefaults();
 
  private:
   // basic state ok?
@@ -144,8 +149,21 @@ class EmitterState {
   SettingChanges m_globalModifiedSettings;
 
   struct Group {
-    explicit Group(GroupType::value type_)
-        : type(type_), indent(0), childCount(0), longKey(false) {}
+    Group()
+        : type(GroupType::NoType),
+          flowType(FlowType::NoType),
+          indent(0),
+          childCount(0),
+          longKey(false) {}
+
+    // for a reused Group (whose modifiedSettings were cleared when it ended)
+    void Start(GroupType::value type_) {
+      type = type_;
+      flowType = FlowType::NoType;
+      indent = 0;
+      childCount = 0;
+      longKey = false;
+    }
 
     GroupType::value type;
     FlowType::value flowType;
@@ -174,7 +192,7 @@ class EmitterState {
     }
   };
 
-  ptr_stack<Group> m_groups;
+  inline_stack<Group> m_groups;
   std::size_t m_curIndent;
   bool m_hasAnchor;
   bool m_hasTag;
@@ -1,5 +1,12 @@
+#include <algorithm>
+#include <cassert>
+#include <clocale>
+#include <cstdio>
+#include <cstring>
 #include <iomanip>
+#include <limits>
 #include <sstream>
+#include <vector>
 
 #include "emitterutils.h"
 #include "exp.h"
@@ -129,27 +136,180 @@ bool GetNextCodePointAndAdvance(int& codePoint,
   return true;
 }
 
-void WriteCodePoint(ostream_wrapper& out, int codePoint) {
+// EncodeCodePoint
+// . Fills 'buffer' (at least 4 bytes) with what WriteCodePoint writes, and
+//   returns its length.
+std::size_t EncodeCodePoint(int codePoint, char* buffer) {
   if (codePoint < 0 || codePoint > 0x10FFFF) {
     codePoint = REPLACEMENT_CHARACTER;
   }
   if (codePoint < 0x7F) {
-    out << static_cast<char>(codePoint);
+    buffer[0] = static_cast<char>(codePoint);
+    return 1;
   } else if (codePoint < 0x7FF) {
-    out << static_cast<char>(0xC0 | (codePoint >> 6))
-        << static_cast<char>(0x80 | (codePoint & 0x3F));
+    buffer[0] = static_cast<char>(0xC0 | (codePoint >> 6));
+    buffer[1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+    return 2;
   } else if (codePoint < 0xFFFF) {
-    out << static_cast<char>(0xE0 | (codePoint >> 12))
-        << static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F))
-        << static_cast<char>(0x80 | (codePoint & 0x3F));
+    buffer[0] = static_cast<char>(0xE0 | (codePoint >> 12));
+    buffer[1] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    buffer[2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+    return 3;
   } else {
-    out << static_cast<char>(0xF0 | (codePoint >> 18))
-        << static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F))
-        << static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F))
-        << static_cast<char>(0x80 | (codePoint & 0x3F));
+    buffer[0] = static_cast<char>(0xF0 | (codePoint >> 18));
+    buffer[1] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+    buffer[2] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    buffer[3] = static_cast<char>(0x80 | (codePoint & 0x3F));
+    return 4;
   }
 }
 
+void WriteCodePoint(ostream_wrapper& out, int codePoint) {
+  char buffer[4];
+  out.write(buffer, EncodeCodePoint(codePoint, buffer));
+}
+
+// IsWrittenAsIs
+// . Whether WriteCodePoint writes 'codePoint' as exactly the bytes it was
+//   read from (it doesn't for invalid or overlong input, for instance), so
+//   they can be copied with the bytes around them.
+bool IsWrittenAsIs(int codePoint, std::string::const_iterator first,
+                   std::string::const_iterator last) {
+  char buffer[4];
+  const std::size_t size = EncodeCodePoint(codePoint, buffer);
+  return static_cast<std::size_t>(last - first) == size &&
+         std::equal(first, last, buffer);
+}
+
+bool IsOneOf(int ch, const char* chars) {
+  return ch != 0 && std::strchr(chars, ch) != 0;
+}
+
+// ByteClass
+// . What ComputeStringFormat and the scalar writers need to know about each
+//   byte, so they can check (or copy) a string with one table lookup per
+//   byte.
+struct ByteClass {
+  enum value {
+    NotPlain = 0x01,        // can't be in a plain scalar
+    NotPlainInFlow = 0x02,  // can't be in a plain scalar in a flow collection
+    PlainIfNot = 0x04,      // can't be in one followed by certain bytes
+    NonAscii = 0x08,
+    Newline = 0x10,
+    NotAsIsInDoubleQuotes = 0x20,  // escaped (or re-encoded)
+    NotAsIsInSingleQuotes = 0x40
+  };
+};
+
+class ByteClassTable {
+ public:
+  ByteClassTable() {
+    for (int ch = 0; ch < 256; ch++) {
+      unsigned char classes = 0;
+
+      // Exp::NotPrintable(), Exp::Break() and Exp::Tab() (but a lone '\r' is
+      // fine)
+      if ((ch < 0x20 && ch != '\r') || ch == 0x7F)
+        classes |= ByteClass::NotPlain;
+      // Exp::EndScalarInFlow()
+      if (IsOneOf(ch, ",?[]{}"))
+        classes |= ByteClass::NotPlainInFlow;
+      // ": ", " #", "\r\n", and the rest of Exp::NotPrintable() and
+      // Exp::Utf8_ByteOrderMark()
+      if (ch == ':' || ch == ' ' || ch == '\r' || ch == 0xC2 || ch == 0xEF)
+        classes |= ByteClass::PlainIfNot;
+      if (ch >= 0x80)
+        classes |= ByteClass::NonAscii;
+      if (ch == '\n')
+        classes |= ByteClass::Newline;
+      // (WriteCodePoint writes 0x7F in two bytes)
+      if (ch < 0x20 || ch == '"' || ch == '\\' || ch >= 0x7F)
+        classes |= ByteClass::NotAsIsInDoubleQuotes;
+      if (ch == '\n' || ch == '\'' || ch >= 0x7F)
+        classes |= ByteClass::NotAsIsInSingleQuotes;
+
+      m_classes[ch] = classes;
+    }
+  }
+
+  unsigned char operator[](char ch) const {
+    return m_classes[static_cast<unsigned char>(ch)];
+  }
+
+ private:
+  unsigned char m_classes[256];
+};
+
+const ByteClassTable& ByteClasses() {
+  static const ByteClassTable table;
+  return table;
+}
+
+// FindByteClass
+// . Returns the index of the first byte (from 'start') in any of 'classes',
+//   or 'size' if there isn't one.
+std::size_t FindByteClass(const std::string& str, std::size_t start,
+                          unsigned classes) {
+  const ByteClassTable& table = ByteClasses();
+  const std::size_t size = str.size();
+  for (std::size_t i = start; i < size; i++) {
+    if (table[str[i]] & classes)
+      return i;
+  }
+  return size;
+}
+
+bool IsBlankOrBreakAt(const std::string& str, std::size_t i) {
+  if (i >= str.size())
+    return false;
+  return str[i] == ' ' || str[i] == '\t' || str[i] == '\n' ||
+         (str[i] == '\r' && i + 1 < str.size() && str[i + 1] == '\n');
+}
+
+// IsPlainStart
+// . Exp::PlainScalar() (or Exp::PlainScalarInFlow()) at the start of 'str'.
+bool IsPlainStart(const std::string& str, FlowType::value flowType) {
+  const bool flow = flowType == FlowType::Flow;
+  const char ch = str[0];
+  if (IsBlankOrBreakAt(str, 0) || IsOneOf(ch, ",[]{}#&*!|>\'\"%@`"))
+    return false;
+
+  if (flow) {
+    if (ch == '?')
+      return false;
+    return !((ch == '-' || ch == ':') && str.size() > 1 &&
+             (str[1] == ' ' || str[1] == '\t'));
+  }
+  return !((ch == '-' || ch == '?' || ch == ':') &&
+           (str.size() == 1 || IsBlankOrBreakAt(str, 1)));
+}
+
+// IsPlainAt
+// . Whether the PlainIfNot byte at 'i' is allowed, given what follows it.
+bool IsPlainAt(const std::string& str, std::size_t i,
+               FlowType::value flowType) {
+  const std::size_t size = str.size();
+  const unsigned char next =
+      i + 1 < size ? static_cast<unsigned char>(str[i + 1]) : 0;
+
+  switch (static_cast<unsigned char>(str[i])) {
+    case ':':  // Exp::EndScalar() or Exp::EndScalarInFlow()
+      if (i + 1 == size || IsBlankOrBreakAt(str, i + 1))
+        return false;
+      return flowType != FlowType::Flow || !IsOneOf(next, ",]}");
+    case ' ':  // a comment
+      return next != '#';
+    case '\r':  // a break
+      return next != '\n';
+    case 0xC2:  // Exp::NotPrintable()
+      return !((next >= 0x80 && next <= 0x84) || (next >= 0x86 && next <= 0x9F));
+    case 0xEF:  // Exp::Utf8_ByteOrderMark()
+      return !(next == 0xBB && i + 2 < size &&
+               static_cast<unsigned char>(str[i + 2]) == 0xBF);
+  }
+  return true;
+}
+
 bool IsValidPlainScalar(const std::string& str, FlowType::value flowType,
                         bool allowOnlyAscii) {
   if (str.empty()) {
@@ -162,39 +322,30 @@ bool IsValidPlainScalar(const std::string& str, FlowType::value flowType,
   }
 
   // check the start
-  const RegEx& start = (flowType == FlowType::Flow ? Exp::PlainScalarInFlow()
-                                                   : Exp::PlainScalar());
-  if (!start.Matches(str)) {
+  if (!IsPlainStart(str, flowType)) {
     return false;
   }
 
   // and check the end for plain whitespace (which can't be faithfully kept in a
   // plain scalar)
-  if (!str.empty() && *str.rbegin() == ' ') {
+  if (*str.rbegin() == ' ') {
     return false;
   }
 
   // then check until something is disallowed
-  static const RegEx& disallowed_flow =
-      Exp::EndScalarInFlow() || (Exp::BlankOrBreak() + Exp::Comment()) ||
-      Exp::NotPrintable() || Exp::Utf8_ByteOrderMark() || Exp::Break() ||
-      Exp::Tab();
-  static const RegEx& disallowed_block =
-      Exp::EndScalar() || (Exp::BlankOrBreak() + Exp::Comment()) ||
-      Exp::NotPrintable() || Exp::Utf8_ByteOrderMark() || Exp::Break() ||
-      Exp::Tab();
-  const RegEx& disallowed =
-      flowType == FlowType::Flow ? disallowed_flow : disallowed_block;
-
-  StringCharSource buffer(str.c_str(), str.size());
-  while (buffer) {
-    if (disallowed.Matches(buffer)) {
-      return false;
-    }
-    if (allowOnlyAscii && (0x80 <= static_cast<unsigned char>(buffer[0]))) {
+  unsigned disallowed = ByteClass::NotPlain;
+  if (flowType == FlowType::Flow)
+    disallowed |= ByteClass::NotPlainInFlow;
+  if (allowOnlyAscii)
+    disallowed |= ByteClass::NonAscii;
+
+  const ByteClassTable& table = ByteClasses();
+  for (std::size_t i = FindByteClass(str, 0, disallowed | ByteClass::PlainIfNot);
+       i < str.size();
+       i = FindByteClass(str, i + 1, disallowed | ByteClass::PlainIfNot)) {
+    if ((table[str[i]] & disallowed) || !IsPlainAt(str, i, flowType)) {
       return false;
     }
-    ++buffer;
   }
 
   return true;
@@ -202,15 +353,10 @@ bool IsValidPlainScalar(const std::string& str, FlowType::value flowType,
 
 bool IsValidSingleQuotedScalar(const std::string& str, bool escapeNonAscii) {
   // TODO: check for non-printable characters?
-  for (std::size_t i = 0; i < str.size(); i++) {
-    if (escapeNonAscii && (0x80 <= static_cast<unsigned char>(str[i]))) {
-      return false;
-    }
-    if (str[i] == '\n') {
-      return false;
-    }
-  }
-  return true;
+  unsigned disallowed = ByteClass::Newline;
+  if (escapeNonAscii)
+    disallowed |= ByteClass::NonAscii;
+  return FindByteClass(str, 0, disallowed) == str.size();
 }
 
 bool IsValidLiteralScalar(const std::string& str, FlowType::value flowType,
@@ -220,12 +366,8 @@ bool IsValidLiteralScalar(const std::string& str, FlowType::value flowType,
   }
 
   // TODO: check for non-printable characters?
-  for (std::size_t i = 0; i < str.size(); i++) {
-    if (escapeNonAscii && (0x80 <= static_cast<unsigned char>(str[i]))) {
-      return false;
-    }
-  }
-  return true;
+  return !escapeNonAscii || FindByteClass(str, 0, ByteClass::NonAscii) ==
+                                str.size();
 }
 
 void WriteDoubleQuoteEscapeSequence(ostream_wrapper& out, int codePoint) {
@@ -261,6 +403,124 @@ bool WriteAliasName(ostream_wrapper& out, const std::string& str) {
   }
   return true;
 }
+
+// WriteRun
+// . Writes [first, last) of 'str' as it is.
+void WriteRun(ostream_wrapper& out, const std::string& str,
+              std::string::const_iterator first,
+              std::string::const_iterator last) {
+  if (first != last)
+    out.write(str.data() + (first - str.begin()), last - first);
+}
+
+// GetDoubleQuotedEscape
+// . Returns the character after the '\\' that 'codePoint' is escaped with in
+//   double quotes ('x' for any hex escape), or 0 if it's written as itself.
+char GetDoubleQuotedEscape(int codePoint, bool escapeNonAscii) {
+  switch (codePoint) {
+    case '\"':
+      return '\"';
+    case '\\':
+      return '\\';
+    case '\n':
+      return 'n';
+    case '\t':
+      return 't';
+    case '\r':
+      return 'r';
+    case '\b':
+      return 'b';
+  }
+  // Control characters and non-breaking space, and byte order marks (ZWNS)
+  // (YAML 1.2, sec. 5.2)
+  if (codePoint < 0x20 || (codePoint >= 0x80 && codePoint <= 0xA0) ||
+      codePoint == 0xFEFF || (escapeNonAscii && codePoint > 0x7E))
+    return 'x';
+  return 0;
+}
+
+void WriteDoubleQuotedCodePoint(ostream_wrapper& out, int codePoint,
+                                bool escapeNonAscii) {
+  const char escape = GetDoubleQuotedEscape(codePoint, escapeNonAscii);
+  if (escape == 'x') {
+    WriteDoubleQuoteEscapeSequence(out, codePoint);
+  } else if (escape) {
+    const char sequence[] = {'\\', escape};
+    out.write(sequence, 2);
+  } else {
+    WriteCodePoint(out, codePoint);
+  }
+}
+
+typedef unsigned long long word_t;
+
+const word_t LowBits = 0x0101010101010101ULL;
+const word_t HighBits = 0x8080808080808080ULL;
+
+// HasZeroOrLess
+// . Nonzero exactly when some byte of 'word' is less than n (for n <= 0x80);
+//   this is the usual SWAR test, eight bytes at once.
+word_t HasZeroOrLess(word_t word, unsigned char n) {
+  return (word - LowBits * n) & ~word & HighBits;
+}
+
+// HasJsonEscape
+// . Whether any byte of 'word' is a control character, '"' or '\\'.
+bool HasJsonEscape(word_t word) {
+  return (HasZeroOrLess(word, 0x20) |
+          HasZeroOrLess(word ^ (LowBits * '\"'), 1) |
+          HasZeroOrLess(word ^ (LowBits * '\\'), 1)) != 0;
+}
+
+bool IsJsonEscape(char ch) {
+  return static_cast<unsigned char>(ch) < 0x20 || ch == '\"' || ch == '\\';
+}
+
+// FindJsonEscape
+// . The first byte of str[i, size) that must be escaped, eight at a time.
+std::size_t FindJsonEscape(const char* str, std::size_t i, std::size_t size) {
+  for (; i + sizeof(word_t) <= size; i += sizeof(word_t)) {
+    word_t word;
+    std::memcpy(&word, str + i, sizeof(word));
+    if (HasJsonEscape(word))
+      break;
+  }
+  while (i < size && !IsJsonEscape(str[i]))
+    i++;
+  return i;
+}
+
+void WriteJsonEscape(ostream_wrapper& out, char ch) {
+  static const char hexDigits[] = "0123456789abcdef";
+  switch (ch) {
+    case '\"':
+      out << "\\\"";
+      break;
+    case '\\':
+      out << "\\\\";
+      break;
+    case '\n':
+      out << "\\n";
+      break;
+    case '\t':
+      out << "\\t";
+      break;
+    case '\r':
+      out << "\\r";
+      break;
+    case '\b':
+      out << "\\b";
+      break;
+    case '\f':
+      out << "\\f";
+      break;
+    default: {
+      const char escape[] = {'\\', 'u', '0', '0', hexDigits[(ch >> 4) & 0xF],
+                             hexDigits[ch & 0xF]};
+      out.write(escape, sizeof(escape));
+    }
+  }
+}
 }
 
 StringFormat::value ComputeStringFormat(const std::string& str,
@@ -292,11 +552,29 @@ StringFormat::value ComputeStringFormat(const std::string& str,
   return StringFormat::DoubleQuoted;
 }
 
+// The quoted string writers copy runs of bytes that come out as they are,
+// and only decode the characters that don't (or might not).
+
 bool WriteSingleQuotedString(ostream_wrapper& out, const std::string& str) {
   out << "'";
-  int codePoint;
-  for (std::string::const_iterator i = str.begin();
-       GetNextCodePointAndAdvance(codePoint, i, str.end());) {
+  const ByteClassTable& table = ByteClasses();
+  std::string::const_iterator run = str.begin();
+  for (std::string::const_iterator i = str.begin(); i != str.end();) {
+    if (!(table[*i] & ByteClass::NotAsIsInSingleQuotes)) {
+      ++i;
+      continue;
+    }
+
+    const std::string::const_iterator start = i;
+    int codePoint;
+    GetNextCodePointAndAdvance(codePoint, i, str.end());
+    if (codePoint != '\n' && codePoint != '\'' &&
+        IsWrittenAsIs(codePoint, start, i)) {
+      continue;
+    }
+
+    WriteRun(out, str, run, start);
+    run = i;
     if (codePoint == '\n') {
       return false;  // We can't handle a new line and the attendant indentation
                      // yet
@@ -308,6 +586,7 @@ bool WriteSingleQuotedString(ostream_wrapper& out, const std::string& str) {
       WriteCodePoint(out, codePoint);
     }
   }
+  WriteRun(out, str, run, str.end());
   out << "'";
   return true;
 }
@@ -315,43 +594,44 @@ bool WriteSingleQuotedString(ostream_wrapper& out, const std::string& str) {
 bool WriteDoubleQuotedString(ostream_wrapper& out, const std::string& str,
                              bool escapeNonAscii) {
   out << "\"";
-  int codePoint;
-  for (std::string::const_iterator i = str.begin();
-       GetNextCodePointAndAdvance(codePoint, i, str.end());) {
-    switch (codePoint) {
-      case '\"':
-        out << "\\\"";
-        break;
-      case '\\':
-        out << "\\\\";
-        break;
-      case '\n':
-        out << "\\n";
-        break;
-      case '\t':
-        out << "\\t";
-        break;
-      case '\r':
-        out << "\\r";
-        break;
-      case '\b':
-        out << "\\b";
-        break;
-      default:
-        if (codePoint < 0x20 ||
-            (codePoint >= 0x80 &&
-             codePoint <= 0xA0)) {  // Control characters and non-breaking space
-          WriteDoubleQuoteEscapeSequence(out, codePoint);
-        } else if (codePoint == 0xFEFF) {  // Byte order marks (ZWNS) should be
-                                           // escaped (YAML 1.2, sec. 5.2)
-          WriteDoubleQuoteEscapeSequence(out, codePoint);
-        } else if (escapeNonAscii && codePoint > 0x7E) {
-          WriteDoubleQuoteEscapeSequence(out, codePoint);
-        } else {
-          WriteCodePoint(out, codePoint);
-        }
+  const ByteClassTable& table = ByteClasses();
+  std::string::const_iterator run = str.begin();
+  for (std::string::const_iterator i = str.begin(); i != str.end();) {
+    if (!(table[*i] & ByteClass::NotAsIsInDoubleQuotes)) {
+      ++i;
+      continue;
+    }
+
+    const std::string::const_iterator start = i;
+    int codePoint;
+    GetNextCodePointAndAdvance(codePoint, i, str.end());
+    if (!GetDoubleQuotedEscape(codePoint, escapeNonAscii) &&
+        IsWrittenAsIs(codePoint, start, i)) {
+      continue;
     }
+
+    WriteRun(out, str, run, start);
+    run = i;
+    WriteDoubleQuotedCodePoint(out, codePoint, escapeNonAscii);
   }
+  WriteRun(out, str, run, str.end());
+  out << "\"";
+  return true;
+}
+
+// WriteJsonString
+// . Escapes only what JSON requires (control characters, '"' and '\\'),
+//   copying the runs in between; other bytes, UTF-8 or not, go as they are.
+bool WriteJsonString(ostream_wrapper& out, const char* str, std::size_t size) {
+  out << "\"";
+  std::size_t run = 0;
+  for (std::size_t i = FindJsonEscape(str, 0, size); i < size;
+       i = FindJsonEscape(str, i, size)) {
+    out.write(str + run, i - run);
+    WriteJsonEscape(out, str[i]);
+    run = ++i;
+  }
+  out.write(str + run, size - run);
   out << "\"";
   return true;
 }
@@ -391,6 +671,96 @@ bool WriteChar(ostream_wrapper& out, char ch) {
   return true;
 }
 
+// FormatInteger
+// . Formats the digits from the back of a buffer, with the same prefixes
+//   (and for Hex, the same lowercase digits) as the stream manipulators.
+std::size_t FormatInteger(char* output, unsigned long long magnitude,
+                          bool negative, EMITTER_MANIP intFormat) {
+  static const char digits[] = "0123456789abcdef";
+
+  char buffer[MaxIntegerSize];
+  char* const end = buffer + sizeof(buffer);
+  char* start = end;
+
+  unsigned base = 10;
+  const char* prefix = "";
+  switch (intFormat) {
+    case Hex:
+      base = 16;
+      prefix = "0x";
+      break;
+    case Oct:
+      base = 8;
+      prefix = "0";
+      break;
+    default:
+      break;
+  }
+
+  if (base == 10) {
+    // (a constant base, so the compiler can avoid the divisions)
+    do {
+      *--start = static_cast<char>('0' + magnitude % 10);
+      magnitude /= 10;
+    } while (magnitude > 0);
+  } else {
+    do {
+      *--start = digits[magnitude % base];
+      magnitude /= base;
+    } while (magnitude > 0);
+  }
+
+  for (std::size_t i = std::strlen(prefix); i > 0; i--)
+    *--start = prefix[i - 1];
+  if (negative)
+    *--start = '-';
+
+  std::memcpy(output, start, end - start);
+  return end - start;
+}
+
+bool WriteInteger(ostream_wrapper& out, unsigned long long magnitude,
+                  bool negative, EMITTER_MANIP intFormat) {
+  char buffer[MaxIntegerSize];
+  out.write(buffer, FormatInteger(buffer, magnitude, negative, intFormat));
+  return true;
+}
+
+// FormatFloatingPoint
+// . Formats what a stream with this precision would (that is, %g), but
+//   always with a '.', whatever the C locale's decimal point is.
+// . The precision is at most digits10 + 1 (EmitterState checks), so %g
+//   needs no more than that many digits, a sign, a point and "e-308".
+std::size_t FormatFloatingPoint(char* output, double value,
+                                std::size_t precision) {
+  assert(precision <= std::numeric_limits<double>::digits10 + 1);
+
+  const int size =
+      std::sprintf(output, "%.*g", static_cast<int>(precision), value);
+  if (size <= 0)
+    return 0;
+
+  const char point = *std::localeconv()->decimal_point;
+  if (point != '.') {
+    for (int i = 0; i < size; i++) {
+      if (output[i] == point)
+        output[i] = '.';
+    }
+  }
+  return size;
+}
+
+bool WriteFloatingPoint(ostream_wrapper& out, double value,
+                        std::size_t precision) {
+  char buffer[MaxFloatingPointSize];
+  const std::size_t size = FormatFloatingPoint(buffer, value, precision);
+  if (size == 0)
+    return false;
+
+  out.write(buffer, size);
+  return true;
+}
+
 bool WriteComment(ostream_wrapper& out, const std::string& str,
                   int postCommentIndent) {
   const std::size_t curIndent = out.col();
@@ -473,9 +843,81 @@ bool WriteTagWithPrefix(ostream_wrapper& out, const std::string& prefix,
   return true;
 }
 
+namespace {
+// bytes encoded at a time (a whole number of groups, and of lines)
+const std::size_t binaryChunkSize = 57 * 64;
+const std::size_t binaryLineWidth = 76;
+}
+
 bool WriteBinary(ostream_wrapper& out, const Binary& binary) {
-  WriteDoubleQuotedString(out, EncodeBase64(binary.data(), binary.size()),
-                          false);
+  // base64 never needs escaping, so it's written as it's encoded
+  const unsigned char* data = binary.data();
+  const std::size_t size = binary.size();
+
+  Base64Encoder encoder;
+  std::string encoded;
+  out << "\"";
+  for (std::size_t i = 0; i < size; i += binaryChunkSize) {
+    encoded.clear();
+    encoder.Encode(data + i, std::min(binaryChunkSize, size - i), encoded);
+    out.write(encoded);
+  }
+  encoded.clear();
+  encoder.Finish(encoded);
+  out << encoded << "\"";
+  return true;
+}
+
+bool WriteBinary(ostream_wrapper& out, const BinaryStream& binary,
+                 int indent) {
+  std::vector<unsigned char> chunk(binaryChunkSize);
+  Base64Encoder encoder;
+  std::string encoded, lines;
+  const std::string lineBreak = "\n" + std::string(std::max(indent, 0), ' ');
+  std::size_t column = 0;
+  bool started = false;
+
+  for (bool done = false; !done;) {
+    const std::size_t size =
+        binary.producer(binary.context, &chunk[0], chunk.size());
+    assert(size <= chunk.size());
+    done = size == 0;
+
+    encoded.clear();
+    if (done)
+      encoder.Finish(encoded);
+    else
+      encoder.Encode(&chunk[0], size, encoded);
+
+    if (!started) {
+      if (done && encoded.empty())
+        break;
+      out << (indent < 0 ? "\"" : "|");
+      started = true;
+    }
+
+    if (indent < 0) {
+      out.write(encoded);
+      continue;
+    }
+    // wrapped a chunk at a time, and written at once
+    lines.clear();
+    for (std::size_t pos = 0; pos < encoded.size();) {
+      if (column == 0)
+        lines.append(lineBreak);
+      const std::size_t n =
+          std::min(binaryLineWidth - column, encoded.size() - pos);
+      lines.append(encoded, pos, n);
+      pos += n;
+      column = (column + n) % binaryLineWidth;
+    }
+    out.write(lines);
+  }
+
+  if (!started)
+    out << "\"\"";
+  else if (indent < 0)
+    out << "\"";
   return true;
 }
 }
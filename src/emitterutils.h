@@ -7,6 +7,7 @@
 #pragma once
 #endif
 
+#include <cstddef>
 #include <string>
 
 #include "emitterstate.h"
@@ -19,6 +20,7 @@ class ostream_wrapper;
 
 namespace YAML {
 class Binary;
+struct BinaryStream;
 
 struct StringFormat {
   enum value { Plain, SingleQuoted, DoubleQuoted, Literal };
@@ -33,9 +35,23 @@ StringFormat::value ComputeStringFormat(const std::string& str,
 bool WriteSingleQuotedString(ostream_wrapper& out, const std::string& str);
 bool WriteDoubleQuotedString(ostream_wrapper& out, const std::string& str,
                              bool escapeNonAscii);
+bool WriteJsonString(ostream_wrapper& out, const char* str, std::size_t size);
 bool WriteLiteralString(ostream_wrapper& out, const std::string& str,
                         int indent);
 bool WriteChar(ostream_wrapper& out, char ch);
+bool WriteInteger(ostream_wrapper& out, unsigned long long magnitude,
+                  bool negative, EMITTER_MANIP intFormat);
+bool WriteFloatingPoint(ostream_wrapper& out, double value,
+                        std::size_t precision);
+
+// the same, into a buffer of (at least) the Max...Size, returning how many
+// characters they wrote (0 if they failed)
+const std::size_t MaxIntegerSize = 32;  // 64 bits in octal, sign and prefix
+const std::size_t MaxFloatingPointSize = 64;
+std::size_t FormatInteger(char* output, unsigned long long magnitude,
+                          bool negative, EMITTER_MANIP intFormat);
+std::size_t FormatFloatingPoint(char* output, double value,
+                                std::size_t precision);
 bool WriteComment(ostream_wrapper& out, const std::string& str,
                   int postCommentIndent);
 bool WriteAlias(ostream_wrapper& out, const std::string& str);
@@ -44,6 +60,10 @@ bool WriteTag(ostream_wrapper& out, const std::string& str, bool verbatim);
 bool WriteTagWithPrefix(ostream_wrapper& out, const std::string& prefix,
                         const std::string& tag);
 bool WriteBinary(ostream_wrapper& out, const Binary& binary);
+
+// writes a literal block at 'indent', or (if that's negative) one
+// double-quoted line
+bool WriteBinary(ostream_wrapper& out, const BinaryStream& binary, int indent);
 }
 }
 
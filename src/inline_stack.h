@@ -0,0 +1,43 @@
+#ifndef INLINE_STACK_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define INLINE_STACK_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <cstddef>
+#include <vector>
+
+// inline_stack
+// . A stack of T held by value. Popping only shrinks the stack, so the next
+//   push gets the same element back (with whatever storage it kept) instead
+//   of a new one; push() callers should reset it.
+template <typename T>
+class inline_stack {
+ public:
+  inline_stack() : m_size(0) {}
+
+  std::size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  T& push() {
+    if (m_size == m_data.size())
+      m_data.push_back(T());
+    return m_data[m_size++];
+  }
+  void pop() { m_size--; }
+
+  T& top() { return m_data[m_size - 1]; }
+  const T& top() const { return m_data[m_size - 1]; }
+
+  T& top(std::ptrdiff_t diff) { return m_data[m_size - 1 + diff]; }
+  const T& top(std::ptrdiff_t diff) const { return m_data[m_size - 1 + diff]; }
+
+ private:
+  std::vector<T> m_data;
+  std::size_t m_size;
+};
+
+#endif  // INLINE_STACK_H_62B23520_7C8E_11DE_8A39_0800200C9A66
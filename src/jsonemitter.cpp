@@ -0,0 +1,191 @@
+#include "yaml-cpp/jsonemitter.h"
+
+#include <limits>
+
+#include "emitterutils.h"
+#include "yaml-cpp/exceptions.h"
+
+namespace YAML {
+JsonEmitter::JsonEmitter()
+    : m_docCount(0),
+      m_floatPrecision(std::numeric_limits<float>::digits10 + 1),
+      m_doublePrecision(std::numeric_limits<double>::digits10 + 1),
+      m_isGood(true) {}
+
+JsonEmitter::JsonEmitter(std::ostream& stream)
+    : m_stream(stream),
+      m_docCount(0),
+      m_floatPrecision(std::numeric_limits<float>::digits10 + 1),
+      m_doublePrecision(std::numeric_limits<double>::digits10 + 1),
+      m_isGood(true) {}
+
+JsonEmitter::JsonEmitter(OutputSink& sink)
+    : m_stream(sink),
+      m_docCount(0),
+      m_floatPrecision(std::numeric_limits<float>::digits10 + 1),
+      m_doublePrecision(std::numeric_limits<double>::digits10 + 1),
+      m_isGood(true) {}
+
+JsonEmitter::~JsonEmitter() {}
+
+const char* JsonEmitter::c_str() const { return m_stream.str(); }
+
+std::size_t JsonEmitter::size() const { return m_stream.pos(); }
+
+void JsonEmitter::Flush() { m_stream.flush(); }
+
+bool JsonEmitter::good() const { return m_isGood; }
+
+const std::string JsonEmitter::GetLastError() const { return m_lastError; }
+
+bool JsonEmitter::SetFloatPrecision(std::size_t n) {
+  if (n > static_cast<std::size_t>(std::numeric_limits<float>::digits10 + 1))
+    return false;
+  m_floatPrecision = n;
+  return true;
+}
+
+bool JsonEmitter::SetDoublePrecision(std::size_t n) {
+  if (n > static_cast<std::size_t>(std::numeric_limits<double>::digits10 + 1))
+    return false;
+  m_doublePrecision = n;
+  return true;
+}
+
+JsonEmitter& JsonEmitter::SetLocalValue(EMITTER_MANIP value) {
+  if (!good())
+    return *this;
+
+  switch (value) {
+    case BeginSeq:
+      BeginGroup(false);
+      break;
+    case EndSeq:
+      EndGroup(false);
+      break;
+    case BeginMap:
+      BeginGroup(true);
+      break;
+    case EndMap:
+      EndGroup(true);
+      break;
+    default:
+      // Key, Value and the formatting manipulators don't change JSON
+      break;
+  }
+  return *this;
+}
+
+JsonEmitter& JsonEmitter::Write(const std::string& str) {
+  return Write(str.data(), str.size());
+}
+
+JsonEmitter& JsonEmitter::Write(const char* str, std::size_t size) {
+  if (!good())
+    return *this;
+
+  PrepareNode();
+  Utils::WriteJsonString(m_stream, str, size);
+  return *this;
+}
+
+JsonEmitter& JsonEmitter::Write(bool b) {
+  if (!good())
+    return *this;
+
+  if (PrepareNode())
+    m_stream << (b ? "\"true\"" : "\"false\"");
+  else
+    m_stream << (b ? "true" : "false");
+  return *this;
+}
+
+JsonEmitter& JsonEmitter::Write(char ch) { return Write(&ch, 1); }
+
+JsonEmitter& JsonEmitter::Write(const _Null&) {
+  if (!good())
+    return *this;
+
+  if (PrepareNode())
+    m_stream << "\"null\"";
+  else
+    m_stream << "null";
+  return *this;
+}
+
+JsonEmitter& JsonEmitter::WriteFloatingPoint(double value,
+                                             std::size_t precision) {
+  if (!good())
+    return *this;
+
+  const bool key = PrepareNode();
+  if (key)
+    m_stream << "\"";
+  // not a number, or infinite
+  if (value != value || value - value != 0)
+    m_stream << "null";
+  else
+    Utils::WriteFloatingPoint(m_stream, value, precision);
+  if (key)
+    m_stream << "\"";
+  return *this;
+}
+
+void JsonEmitter::WriteIntegralBits(unsigned long long bits, bool negative,
+                                    bool key) {
+  if (key)
+    m_stream << "\"";
+  Utils::WriteInteger(m_stream, negative ? 0 - bits : bits, negative, Dec);
+  if (key)
+    m_stream << "\"";
+}
+
+// PrepareNode
+// . Writes what separates this node from the last, and returns whether
+//   it's a map's key.
+bool JsonEmitter::PrepareNode() {
+  if (m_groups.empty()) {
+    if (m_docCount++ > 0)
+      m_stream << "\n";
+    return false;
+  }
+
+  Group& group = m_groups.back();
+  const std::size_t index = group.childCount++;
+  if (group.isMap && index % 2 == 1) {
+    m_stream << ":";
+    return false;
+  }
+  if (index > 0)
+    m_stream << ",";
+  return group.isMap;
+}
+
+void JsonEmitter::BeginGroup(bool isMap) {
+  if (PrepareNode())
+    return SetError(ErrorMsg::JSON_COLLECTION_KEY);
+
+  Group group = {isMap, 0};
+  m_groups.push_back(group);
+  m_stream << (isMap ? "{" : "[");
+}
+
+void JsonEmitter::EndGroup(bool isMap) {
+  if (m_groups.empty() || m_groups.back().isMap != isMap) {
+    if (isMap)
+      return SetError(ErrorMsg::UNEXPECTED_END_MAP);
+    else
+      return SetError(ErrorMsg::UNEXPECTED_END_SEQ);
+  }
+  if (isMap && m_groups.back().childCount % 2 == 1)
+    return SetError(ErrorMsg::JSON_MISSING_VALUE);
+
+  m_groups.pop_back();
+  m_stream << (isMap ? "}" : "]");
+}
+
+void JsonEmitter::SetError(const std::string& error) {
+  m_isGood = false;
+  m_lastError = error;
+}
+}
@@ -1,49 +1,182 @@
 #include "yaml-cpp/node.h"
 
 #include <cassert>
+#include <cstring>
 #include <stdexcept>
 
 #include "iterpriv.h"
-#include "nodebuilder.h"
 #include "nodeownership.h"
 #include "yaml-cpp/aliasmanager.h"
 #include "yaml-cpp/anchor.h"
 #include "yaml-cpp/emitfromevents.h"
 #include "yaml-cpp/eventhandler.h"
 #include "yaml-cpp/ltnode.h"
+#include "yaml-cpp/stringpool.h"
+
+namespace {
+// a null node reads as this scalar
+const std::string NullScalar("~");
+
+// what an empty tag, or a node that isn't a scalar, points to
+const std::string EmptyString;
+
+// StoreString
+// . Returns where a node should point to hold 'str': the shared empty string,
+//   the copy interned in 'pPool', or (setting 'owned') a copy of its own.
+const std::string* StoreString(const std::string& str, YAML::StringPool* pPool,
+                               bool& owned) {
+  owned = false;
+  if (str.empty())
+    return &EmptyString;
+  if (pPool)
+    return &pPool->Intern(str);
+  owned = true;
+  return new std::string(str);
+}
+
+void ReleaseString(const std::string*& pString, bool& owned) {
+  if (owned)
+    delete pString;
+  pString = &EmptyString;
+  owned = false;
+}
+
+// MayBeNumber
+// . Returns false if 'str' can't be a number (stream extraction skips
+//   leading whitespace, then needs a sign, a digit, or a '.' for .inf/.nan).
+bool MayBeNumber(const std::string& str) {
+  for (std::size_t i = 0; i < str.size(); i++) {
+    switch (str[i]) {
+      case ' ':
+      case '\t':
+      case '\n':
+      case '\v':
+      case '\f':
+      case '\r':
+        continue;
+      case '+':
+      case '-':
+      case '.':
+        return true;
+      default:
+        return '0' <= str[i] && str[i] <= '9';
+    }
+  }
+  return false;
+}
+}
 
 namespace YAML {
 bool ltnode::operator()(const Node* pNode1, const Node* pNode2) const {
   return *pNode1 < *pNode2;
 }
 
-Node::Node() : m_pOwnership(new NodeOwnership), m_type(NodeType::Null) {}
+Node::Node()
+    : m_pOwnership(new NodeOwnership),
+      m_aliasAnchor(NullAnchor),
+      m_pTag(&EmptyString),
+      m_type(NodeType::Null),
+      m_pScalarData(&EmptyString),
+      m_ownsTag(false),
+      m_ownsScalarData(false),
+      m_hint(ScalarHint::Unknown),
+      m_pCache(0) {}
 
 Node::Node(NodeOwnership& owner)
-    : m_pOwnership(new NodeOwnership(&owner)), m_type(NodeType::Null) {}
+    : m_pOwnership(new NodeOwnership(&owner)),
+      m_aliasAnchor(NullAnchor),
+      m_pTag(&EmptyString),
+      m_type(NodeType::Null),
+      m_pScalarData(&EmptyString),
+      m_ownsTag(false),
+      m_ownsScalarData(false),
+      m_hint(ScalarHint::Unknown),
+      m_pCache(0) {}
 
 Node::~Node() { Clear(); }
 
 void Node::Clear() {
   m_pOwnership.reset(new NodeOwnership);
+  m_aliasAnchor = NullAnchor;
   m_type = NodeType::Null;
-  m_tag.clear();
-  m_scalarData.clear();
+  ReleaseString(m_pTag, m_ownsTag);
+  ReleaseString(m_pScalarData, m_ownsScalarData);
+  m_hint = ScalarHint::Unknown;
+  delete m_pCache;
+  m_pCache = 0;
   m_seqData.clear();
   m_mapData.clear();
 }
 
-bool Node::IsAliased() const { return m_pOwnership->IsAliased(*this); }
-
 Node& Node::CreateNode() { return m_pOwnership->Create(); }
 
+// Clone
+// . Deep-copies this node directly, without replaying it as events.
+// . Aliased nodes are copied once and shared again in the copy; the
+//   'clones' table maps each aliased source node's anchor to its copy.
 std::auto_ptr<Node> Node::Clone() const {
   std::auto_ptr<Node> pNode(new Node);
-  NodeBuilder nodeBuilder(*pNode);
-  EmitEvents(nodeBuilder);
+  clone_map clones;
+  pNode->CopyFrom(*this, clones);
   return pNode;
 }
 
+Node& Node::CloneChild(const Node& source, clone_map& clones) {
+  const anchor_t anchor = source.m_aliasAnchor;
+  if (anchor != NullAnchor) {
+    if (anchor >= clones.size())
+      clones.resize(anchor + 1, 0);
+    if (Node* pClone = clones[anchor]) {
+      pClone->MarkAsAliased(anchor);
+      return *pClone;
+    }
+  }
+
+  Node& node = CreateNode();
+  if (anchor != NullAnchor)
+    clones[anchor] = &node;
+  node.CopyFrom(source, clones);
+  return node;
+}
+
+void Node::CopyFrom(const Node& source, clone_map& clones) {
+  m_mark = source.m_mark;
+  m_type = source.m_type;
+  m_style = source.m_style;
+
+  // interned strings are shared with the source's pool
+  m_ownsTag = source.m_ownsTag;
+  m_pTag = m_ownsTag ? new std::string(*source.m_pTag) : source.m_pTag;
+
+  switch (m_type) {
+    case NodeType::Null:
+      break;
+    case NodeType::Scalar:
+      m_ownsScalarData = source.m_ownsScalarData;
+      m_pScalarData = m_ownsScalarData
+                          ? new std::string(*source.m_pScalarData)
+                          : source.m_pScalarData;
+      m_hint = source.m_hint;
+      if (source.m_pCache)
+        m_pCache = new ScalarCache(*source.m_pCache);
+      break;
+    case NodeType::Sequence:
+      m_seqData.reserve(source.m_seqData.size());
+      for (std::size_t i = 0; i < source.m_seqData.size(); i++)
+        m_seqData.push_back(&CloneChild(*source.m_seqData[i], clones));
+      break;
+    case NodeType::Map:
+      // the source is already sorted, so every insertion goes at the end
+      for (node_map::const_iterator it = source.m_mapData.begin();
+           it != source.m_mapData.end(); ++it) {
+        Node& key = CloneChild(*it->first, clones);
+        Node& value = CloneChild(*it->second, clones);
+        m_mapData.insert(m_mapData.end(), std::make_pair(&key, &value));
+      }
+      break;
+  }
+}
+
 void Node::EmitEvents(EventHandler& eventHandler) const {
   eventHandler.OnDocumentStart(m_mark);
   AliasManager am;
@@ -69,16 +202,17 @@ void Node::EmitEvents(AliasManager& am, EventHandler& eventHandler) const {
       eventHandler.OnNull(m_mark, anchor);
       break;
     case NodeType::Scalar:
-      eventHandler.OnScalar(m_mark, m_tag, anchor, m_scalarData);
+      eventHandler.OnScalarWithHint(m_mark, *m_pTag, anchor, *m_pScalarData,
+                                    m_hint);
       break;
     case NodeType::Sequence:
-      eventHandler.OnSequenceStart(m_mark, m_tag, anchor, m_style);
+      eventHandler.OnSequenceStart(m_mark, *m_pTag, anchor, m_style);
       for (std::size_t i = 0; i < m_seqData.size(); i++)
         m_seqData[i]->EmitEvents(am, eventHandler);
       eventHandler.OnSequenceEnd();
       break;
     case NodeType::Map:
-      eventHandler.OnMapStart(m_mark, m_tag, anchor, m_style);
+      eventHandler.OnMapStart(m_mark, *m_pTag, anchor, m_style);
       for (node_map::const_iterator it = m_mapData.begin();
            it != m_mapData.end(); ++it) {
         it->first->EmitEvents(am, eventHandler);
@@ -90,19 +224,89 @@ void Node::EmitEvents(AliasManager& am, EventHandler& eventHandler) const {
 }
 
 void Node::Init(NodeType::value type, const Mark& mark, const std::string& tag,
-                EmitterStyle::value style) {
+                EmitterStyle::value style, StringPool* pPool) {
   Clear();
   m_mark = mark;
   m_type = type;
-  m_tag = tag;
+  m_pTag = StoreString(tag, pPool, m_ownsTag);
   m_style = style;
 }
 
-void Node::MarkAsAliased() { m_pOwnership->MarkAsAliased(*this); }
+void Node::MarkAsAliased(anchor_t anchor) { m_aliasAnchor = anchor; }
 
-void Node::SetScalarData(const std::string& data) {
+void Node::SetScalarData(const std::string& data, ScalarHint::value hint,
+                         StringPool* pPool) {
   assert(m_type == NodeType::Scalar);  // TODO: throw?
-  m_scalarData = data;
+  ReleaseString(m_pScalarData, m_ownsScalarData);
+  m_pScalarData = StoreString(data, pPool, m_ownsScalarData);
+  m_hint = hint;
+  delete m_pCache;
+  m_pCache = 0;
+}
+
+// CacheConversions
+// . Only on request, since most scalars are read once, if at all; and it
+//   fills every cache up front, so reading the tree stays const-safe.
+void Node::CacheConversions() {
+  switch (m_type) {
+    case NodeType::Null:
+      break;
+    case NodeType::Scalar:
+      if (!m_pCache)
+        CacheScalarConversions();
+      break;
+    case NodeType::Sequence:
+      for (std::size_t i = 0; i < m_seqData.size(); i++)
+        m_seqData[i]->CacheConversions();
+      break;
+    case NodeType::Map:
+      for (node_map::const_iterator it = m_mapData.begin();
+           it != m_mapData.end(); ++it) {
+        it->first->CacheConversions();
+        it->second->CacheConversions();
+      }
+      break;
+  }
+}
+
+// CacheScalarConversions
+// . Parses the scalar once as each of the types Read<T>() is most often
+//   asked for; a plain scalar's hint says which of them can succeed.
+void Node::CacheScalarConversions() {
+  const std::string& scalar = *m_pScalarData;
+  const ScalarHint::value hint = m_hint;
+  m_pCache = new ScalarCache;
+  ScalarCache& cache = *m_pCache;
+
+  const bool plain = IsPlainHint(hint);
+  if (plain ? hint == ScalarHint::Int : MayBeNumber(scalar)) {
+    if (Convert(scalar, cache.integerValue))
+      cache.flags |= ScalarCache::Integer;
+  }
+  if (plain ? hint == ScalarHint::Int || hint == ScalarHint::Float
+            : MayBeNumber(scalar)) {
+    if (Convert(scalar, cache.doubleValue))
+      cache.flags |= ScalarCache::Double;
+  }
+
+  if (plain && hint != ScalarHint::Bool && hint != ScalarHint::Null)
+    return;
+
+  switch (ClassifyKeyword(scalar.data(), scalar.size())) {
+    case ScalarKeyword::True:
+      cache.flags |= ScalarCache::Bool;
+      cache.boolValue = true;
+      break;
+    case ScalarKeyword::False:
+      cache.flags |= ScalarCache::Bool;
+      cache.boolValue = false;
+      break;
+    case ScalarKeyword::Null:
+      cache.flags |= ScalarCache::Null;
+      break;
+    case ScalarKeyword::None:
+      break;
+  }
 }
 
 void Node::Append(Node& node) {
@@ -174,20 +378,61 @@ const Node* Node::FindAtIndex(std::size_t i) const {
 }
 
 bool Node::GetScalar(std::string& s) const {
+  const std::string* pScalar = ScalarText();
+  if (!pScalar)
+    return false;
+
+  s = *pScalar;
+  return true;
+}
+
+bool Node::GetScalar(const char*& data, std::size_t& size) const {
+  const std::string* pScalar = ScalarText();
+  if (!pScalar)
+    return false;
+
+  data = pScalar->data();
+  size = pScalar->size();
+  return true;
+}
+
+ScalarHint::value Node::Hint() const {
   switch (m_type) {
     case NodeType::Null:
-      s = "~";
-      return true;
+      return ScalarHint::Null;
     case NodeType::Scalar:
-      s = m_scalarData;
-      return true;
+      return m_hint;
     case NodeType::Sequence:
     case NodeType::Map:
-      return false;
+      return ScalarHint::Unknown;
   }
 
   assert(false);
-  return false;
+  return ScalarHint::Unknown;
+}
+
+const std::string& Node::Scalar() const {
+  const std::string* pScalar = ScalarText();
+  if (!pScalar)
+    throw InvalidScalar(m_mark);
+  return *pScalar;
+}
+
+// ScalarText
+// . Returns the text a scalar conversion reads, or null for a collection.
+const std::string* Node::ScalarText() const {
+  switch (m_type) {
+    case NodeType::Null:
+      return &NullScalar;
+    case NodeType::Scalar:
+      return m_pScalarData;
+    case NodeType::Sequence:
+    case NodeType::Map:
+      return 0;
+  }
+
+  assert(false);
+  return 0;
 }
 
 Emitter& operator<<(Emitter& out, const Node& node) {
@@ -196,6 +441,21 @@ Emitter& operator<<(Emitter& out, const Node& node) {
   return out;
 }
 
+// FindValueForKey
+// . Looks up a string key by comparing it to each key's scalar in place
+//   (rather than reading each key into a std::string).
+const Node* Node::FindValueForKey(const char* key, std::size_t size) const {
+  for (node_map::const_iterator it = m_mapData.begin(); it != m_mapData.end();
+       ++it) {
+    const std::string* pKey = it->first->ScalarText();
+    if (pKey && pKey->size() == size &&
+        std::memcmp(pKey->data(), key, size) == 0)
+      return it->second;
+  }
+
+  return 0;
+}
+
 int Node::Compare(const Node& rhs) const {
   if (m_type != rhs.m_type)
     return rhs.m_type - m_type;
@@ -204,7 +464,9 @@ int Node::Compare(const Node& rhs) const {
     case NodeType::Null:
       return 0;
     case NodeType::Scalar:
-      return m_scalarData.compare(rhs.m_scalarData);
+      if (m_pScalarData == rhs.m_pScalarData)
+        return 0;
+      return m_pScalarData->compare(*rhs.m_pScalarData);
     case NodeType::Sequence:
       if (m_seqData.size() < rhs.m_seqData.size())
         return 1;
@@ -6,8 +6,11 @@
 namespace YAML {
 struct Mark;
 
-NodeBuilder::NodeBuilder(Node& root)
-    : m_root(root), m_initializedRoot(false), m_finished(false) {
+NodeBuilder::NodeBuilder(Node& root, StringPool* pPool)
+    : m_root(root),
+      m_pPool(pPool),
+      m_initializedRoot(false),
+      m_finished(false) {
   m_root.Clear();
   m_anchors.push_back(0);  // since the anchors start at 1
 }
@@ -27,21 +30,27 @@ void NodeBuilder::OnNull(const Mark& mark, anchor_t anchor) {
 void NodeBuilder::OnAlias(const Mark& /*mark*/, anchor_t anchor) {
   Node& node = *m_anchors[anchor];
   Insert(node);
-  node.MarkAsAliased();
+  node.MarkAsAliased(anchor);
 }
 
 void NodeBuilder::OnScalar(const Mark& mark, const std::string& tag,
                            anchor_t anchor, const std::string& value) {
+  OnScalarWithHint(mark, tag, anchor, value, ScalarHint::Unknown);
+}
+
+void NodeBuilder::OnScalarWithHint(const Mark& mark, const std::string& tag,
+                                   anchor_t anchor, const std::string& value,
+                                   ScalarHint::value hint) {
   Node& node = Push(anchor);
-  node.Init(NodeType::Scalar, mark, tag, EmitterStyle::Default);
-  node.SetScalarData(value);
+  node.Init(NodeType::Scalar, mark, tag, EmitterStyle::Default, m_pPool);
+  node.SetScalarData(value, hint, m_pPool);
   Pop();
 }
 
 void NodeBuilder::OnSequenceStart(const Mark& mark, const std::string& tag,
                                   anchor_t anchor, EmitterStyle::value style) {
   Node& node = Push(anchor);
-  node.Init(NodeType::Sequence, mark, tag, style);
+  node.Init(NodeType::Sequence, mark, tag, style, m_pPool);
 }
 
 void NodeBuilder::OnSequenceEnd() { Pop(); }
@@ -49,7 +58,7 @@ void NodeBuilder::OnSequenceEnd() { Pop(); }
 void NodeBuilder::OnMapStart(const Mark& mark, const std::string& tag,
                              anchor_t anchor, EmitterStyle::value style) {
   Node& node = Push(anchor);
-  node.Init(NodeType::Map, mark, tag, style);
+  node.Init(NodeType::Map, mark, tag, style, m_pPool);
   m_didPushKey.push(false);
 }
 
@@ -22,10 +22,11 @@ struct Mark;
 
 namespace YAML {
 class Node;
+class StringPool;
 
 class NodeBuilder : public EventHandler {
  public:
-  explicit NodeBuilder(Node& root);
+  explicit NodeBuilder(Node& root, StringPool* pPool = 0);
   virtual ~NodeBuilder();
 
   virtual void OnDocumentStart(const Mark& mark);
@@ -35,6 +36,9 @@ class NodeBuilder : public EventHandler {
   virtual void OnAlias(const Mark& mark, anchor_t anchor);
   virtual void OnScalar(const Mark& mark, const std::string& tag,
                         anchor_t anchor, const std::string& value);
+  virtual void OnScalarWithHint(const Mark& mark, const std::string& tag,
+                                anchor_t anchor, const std::string& value,
+                                ScalarHint::value hint);
 
   virtual void OnSequenceStart(const Mark& mark, const std::string& tag,
                                anchor_t anchor, EmitterStyle::value style);
@@ -55,6 +59,7 @@ class NodeBuilder : public EventHandler {
 
  private:
   Node& m_root;
+  StringPool* m_pPool;
   bool m_initializedRoot;
   bool m_finished;
 
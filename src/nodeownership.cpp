@@ -14,12 +14,4 @@ Node& NodeOwnership::_Create() {
   m_nodes.push_back(std::auto_ptr<Node>(new Node));
   return m_nodes.back();
 }
-
-void NodeOwnership::_MarkAsAliased(const Node& node) {
-  m_aliasedNodes.insert(&node);
-}
-
-bool NodeOwnership::_IsAliased(const Node& node) const {
-  return m_aliasedNodes.count(&node) > 0;
-}
 }
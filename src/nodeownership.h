@@ -9,7 +9,6 @@
 
 #include "yaml-cpp/noncopyable.h"
 #include "ptr_vector.h"
-#include <set>
 
 namespace YAML {
 class Node;
@@ -20,17 +19,12 @@ class NodeOwnership : private noncopyable {
   ~NodeOwnership();
 
   Node& Create() { return m_pOwner->_Create(); }
-  void MarkAsAliased(const Node& node) { m_pOwner->_MarkAsAliased(node); }
-  bool IsAliased(const Node& node) const { return m_pOwner->_IsAliased(node); }
 
  private:
   Node& _Create();
-  void _MarkAsAliased(const Node& node);
-  bool _IsAliased(const Node& node) const;
 
  private:
   ptr_vector<Node> m_nodes;
-  std::set<const Node*> m_aliasedNodes;
   NodeOwnership* m_pOwner;
 };
 }
@@ -6,52 +6,115 @@
 
 namespace YAML {
 ostream_wrapper::ostream_wrapper()
-    : m_buffer(1, '\0'),
-      m_pStream(0),
+    : m_pSink(0),
       m_pos(0),
+      m_flushed(0),
       m_row(0),
       m_col(0),
       m_comment(false) {}
 
-ostream_wrapper::ostream_wrapper(std::ostream& stream)
-    : m_pStream(&stream), m_pos(0), m_row(0), m_col(0), m_comment(false) {}
+ostream_wrapper::ostream_wrapper(std::ostream& stream, std::size_t block_size)
+    : m_buffer(block_size, '\0'),
+      m_pStreamSink(new StreamSink(stream)),
+      m_pSink(m_pStreamSink.get()),
+      m_pos(0),
+      m_flushed(0),
+      m_row(0),
+      m_col(0),
+      m_comment(false) {}
+
+ostream_wrapper::ostream_wrapper(OutputSink& sink, std::size_t block_size)
+    : m_buffer(block_size, '\0'),
+      m_pSink(&sink),
+      m_pos(0),
+      m_flushed(0),
+      m_row(0),
+      m_col(0),
+      m_comment(false) {}
 
-ostream_wrapper::~ostream_wrapper() {}
+ostream_wrapper::~ostream_wrapper() { flush(); }
 
 void ostream_wrapper::write(const std::string& str) {
-  if (m_pStream) {
-    m_pStream->write(str.c_str(), str.size());
-  } else {
-    m_buffer.resize(std::max(m_buffer.size(), m_pos + str.size() + 1));
-    std::copy(str.begin(), str.end(), m_buffer.begin() + m_pos);
-  }
-
-  for (std::size_t i = 0; i < str.size(); i++) {
-    update_pos(str[i]);
-  }
+  write(str.data(), str.size());
 }
 
 void ostream_wrapper::write(const char* str, std::size_t size) {
-  if (m_pStream) {
-    m_pStream->write(str, size);
+  if (m_pSink) {
+    if (m_pos - m_flushed + size > m_buffer.size())
+      flush();
+
+    // too big for the block, so it can go straight to the sink
+    if (size >= m_buffer.size()) {
+      m_pSink->Write(str, size);
+      m_flushed += size;
+    } else {
+      std::copy(str, str + size, m_buffer.begin() + (m_pos - m_flushed));
+    }
   } else {
-    m_buffer.resize(std::max(m_buffer.size(), m_pos + size + 1));
-    std::copy(str, str + size, m_buffer.begin() + m_pos);
+    if (m_pos + size > m_buffer.capacity())
+      m_buffer.reserve(std::max(m_pos + size, 2 * m_buffer.capacity()));
+    m_buffer.append(str, size);
   }
 
-  for (std::size_t i = 0; i < size; i++) {
-    update_pos(str[i]);
+  update_pos(str, size);
+}
+
+void ostream_wrapper::flush() {
+  if (!m_pSink || m_pos == m_flushed)
+    return;
+
+  m_pSink->Write(m_buffer.data(), m_pos - m_flushed);
+  m_flushed = m_pos;
+}
+
+void ostream_wrapper::clear() {
+  flush();
+  if (!m_pSink)
+    m_buffer.clear();
+  m_pos = 0;
+  m_flushed = 0;
+  m_row = 0;
+  m_col = 0;
+  m_comment = false;
+}
+
+void ostream_wrapper::reserve(std::size_t size) {
+  if (!m_pSink)
+    m_buffer.reserve(size);
+}
+
+void ostream_wrapper::take(std::string& output) {
+  if (m_pSink) {
+    output.clear();
+  } else {
+    // what 'output' held goes (cleared) to our next output
+    output.swap(m_buffer);
   }
+  clear();
 }
 
-void ostream_wrapper::update_pos(char ch) {
-  m_pos++;
-  m_col++;
+// update_pos
+// . Counts the newlines with memchr, rather than looking at each character;
+//   the column is whatever follows the last one.
+void ostream_wrapper::update_pos(const char* str, std::size_t size) {
+  m_pos += size;
 
-  if (ch == '\n') {
+  const char* const end = str + size;
+  const char* pLastNewline = 0;
+  for (const char* p = str; p < end; p = pLastNewline + 1) {
+    const char* pNewline =
+        static_cast<const char*>(std::memchr(p, '\n', end - p));
+    if (!pNewline)
+      break;
     m_row++;
-    m_col = 0;
+    pLastNewline = pNewline;
+  }
+
+  if (pLastNewline) {
+    m_col = end - (pLastNewline + 1);
     m_comment = false;
+  } else {
+    m_col += size;
   }
 }
 }
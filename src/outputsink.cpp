@@ -0,0 +1,47 @@
+#include "yaml-cpp/outputsink.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ostream>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace YAML {
+void StreamSink::Write(const char* data, std::size_t size) {
+  m_stream.write(data, size);
+}
+
+void FileDescriptorSink::Write(const char* data, std::size_t size) {
+  while (size > 0 && m_error == 0) {
+#if defined(_WIN32)
+    const int written = ::_write(m_fd, data, static_cast<unsigned>(size));
+#else
+    const ssize_t written = ::write(m_fd, data, size);
+#endif
+    if (written < 0) {
+      if (errno != EINTR)
+        m_error = errno;
+      continue;
+    }
+    data += written;
+    size -= written;
+  }
+}
+
+void FixedBufferSink::Write(const char* data, std::size_t size) {
+  if (m_overflowed)
+    return;
+
+  const std::size_t fits = std::min(size, m_capacity - m_size);
+  if (fits > 0) {
+    std::memcpy(m_buffer + m_size, data, fits);
+    m_size += fits;
+  }
+  m_overflowed = fits < size;
+}
+}
@@ -53,6 +53,13 @@ bool Parser::GetNextDocument(Node& document) {
   return HandleNextDocument(builder);
 }
 
+// . Same, but the document's scalars and tags are interned in 'pool', which
+//   must outlive the document.
+bool Parser::GetNextDocument(Node& document, StringPool& pool) {
+  NodeBuilder builder(document, &pool);
+  return HandleNextDocument(builder);
+}
+
 // ParseDirectives
 // . Reads any directives that are next in the queue.
 void Parser::ParseDirectives() {
@@ -35,6 +35,10 @@ class ptr_vector : private YAML::noncopyable {
     m_data.push_back(NULL);
     m_data.back() = t.release();
   }
+  void pop_back() {
+    delete m_data.back();
+    m_data.pop_back();
+  }
   T& operator[](std::size_t i) { return *m_data[i]; }
   const T& operator[](std::size_t i) const { return *m_data[i]; }
 
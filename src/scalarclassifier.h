@@ -0,0 +1,64 @@
+#ifndef SCALARCLASSIFIER_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define SCALARCLASSIFIER_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <cstddef>
+
+#include "yaml-cpp/scalarhint.h"
+
+namespace YAML {
+// ScalarClassifier
+// . Works out a plain scalar's ScalarHint a character at a time, as the
+//   scanner reads it, so it doesn't have to parse the scalar again.
+// . Only number syntax needs every character (any whitespace will do for a
+//   line break); keywords and .inf/.nan are looked up in the finished scalar.
+// . It checks syntax, not range: Int and Float may still overflow.
+class ScalarClassifier {
+ public:
+  ScalarClassifier()
+      : m_integer(I_START), m_base(10), m_float(F_START), m_number(true) {}
+
+  void Add(char ch) {
+    if (m_number)
+      Step(ch);
+  }
+  ScalarHint::value Finish(const char* scalar, std::size_t size) const;
+
+ private:
+  void Step(char ch);
+
+  enum INTEGER_STATE {
+    I_START,
+    I_SIGN,
+    I_ZERO,
+    I_PREFIX,
+    I_DIGITS,
+    I_TRAIL,
+    I_FAIL
+  };
+  enum FLOAT_STATE {
+    F_START,
+    F_SIGN,
+    F_DOT,
+    F_WHOLE,
+    F_FRACTION,
+    F_EXPONENT_MARK,
+    F_EXPONENT_SIGN,
+    F_EXPONENT,
+    F_TRAIL,
+    F_FAIL
+  };
+
+  INTEGER_STATE m_integer;
+  unsigned m_base;
+  FLOAT_STATE m_float;
+  bool m_number;  // false once it can't be either
+};
+}
+
+#endif  // SCALARCLASSIFIER_H_62B23520_7C8E_11DE_8A39_0800200C9A66
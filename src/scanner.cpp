@@ -355,13 +355,25 @@ void Scanner::PopIndent() {
 
   if (indent.status != IndentMarker::VALID) {
     InvalidateSimpleKey();
-    return;
-  }
-
-  if (indent.type == IndentMarker::SEQ)
+  } else if (indent.type == IndentMarker::SEQ) {
     m_tokens.push(Token(Token::BLOCK_SEQ_END, INPUT.mark()));
-  else if (indent.type == IndentMarker::MAP)
+  } else if (indent.type == IndentMarker::MAP) {
     m_tokens.push(Token(Token::BLOCK_MAP_END, INPUT.mark()));
+  }
+
+  CollectIndents();
+}
+
+// CollectIndents
+// . Frees the indent markers pushed after the top one (which have all been
+//   popped), so that a long stream doesn't keep one for every block; a
+//   simple key may still point to one, so we wait until there are none.
+void Scanner::CollectIndents() {
+  if (!m_simpleKeys.empty() || m_indents.empty())
+    return;
+
+  while (&m_indentRefs.back() != m_indents.top())
+    m_indentRefs.pop_back();
 }
 
 // GetTopIndent
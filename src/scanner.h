@@ -68,6 +68,7 @@ class Scanner {
   void PopIndentToHere();
   void PopAllIndents();
   void PopIndent();
+  void CollectIndents();
   int GetTopIndent() const;
 
   // checking input
@@ -4,6 +4,7 @@
 
 #include "exp.h"
 #include "regeximpl.h"
+#include "scalarclassifier.h"
 #include "stream.h"
 #include "yaml-cpp/exceptions.h"  // IWYU pragma: keep
 
@@ -26,6 +27,7 @@ std::string ScanScalar(Stream& INPUT, ScanScalarParams& params) {
   bool foldedNewlineStartedMoreIndented = false;
   std::size_t lastEscapedChar = std::string::npos;
   std::string scalar;
+  ScalarClassifier classifier;
   params.leadingSpaces = false;
 
   while (INPUT) {
@@ -61,7 +63,10 @@ std::string ScanScalar(Stream& INPUT, ScanScalarParams& params) {
 
       // escape this?
       if (INPUT.peek() == params.escape) {
-        scalar += Exp::Escape(INPUT);
+        const std::string escaped = Exp::Escape(INPUT);
+        scalar += escaped;
+        for (std::size_t i = 0; params.classify && i < escaped.size(); i++)
+          classifier.Add(escaped[i]);
         lastNonWhitespaceChar = scalar.size();
         lastEscapedChar = scalar.size();
         continue;
@@ -70,6 +75,8 @@ std::string ScanScalar(Stream& INPUT, ScanScalarParams& params) {
       // otherwise, just add the damn character
       char ch = INPUT.get();
       scalar += ch;
+      if (params.classify)
+        classifier.Add(ch);
       if (ch != ' ' && ch != '\t')
         lastNonWhitespaceChar = scalar.size();
     }
@@ -103,6 +110,10 @@ std::string ScanScalar(Stream& INPUT, ScanScalarParams& params) {
     n = Exp::Break().Match(INPUT);
     INPUT.eat(n);
 
+    // however it's folded, a line break is whitespace in the scalar
+    if (params.classify)
+      classifier.Add('\n');
+
     // ********************************
     // Phase #3: scan initial spaces
 
@@ -216,6 +227,8 @@ std::string ScanScalar(Stream& INPUT, ScanScalarParams& params) {
       break;
   }
 
+  if (params.classify)
+    params.hint = classifier.Finish(scalar.data(), scalar.size());
   return scalar;
 }
 }
@@ -11,6 +11,7 @@
 
 #include "regex_yaml.h"
 #include "stream.h"
+#include "yaml-cpp/scalarhint.h"
 
 namespace YAML {
 enum CHOMP { STRIP = -1, CLIP, KEEP };
@@ -29,7 +30,9 @@ struct ScanScalarParams {
         chomp(CLIP),
         onDocIndicator(NONE),
         onTabInIndentation(NONE),
-        leadingSpaces(false) {}
+        classify(false),
+        leadingSpaces(false),
+        hint(ScalarHint::Unknown) {}
 
   // input:
   RegEx end;          // what condition ends this scalar?
@@ -50,9 +53,11 @@ struct ScanScalarParams {
   ACTION onDocIndicator;      // what do we do if we see a document indicator?
   ACTION onTabInIndentation;  // what do we do if we see a tab where we should
                               // be seeing indentation spaces
+  bool classify;  // should we work out what a plain scalar resolves to?
 
   // output:
   bool leadingSpaces;
+  ScalarHint::value hint;  // if we were asked to classify it
 };
 
 std::string ScanScalar(Stream& INPUT, ScanScalarParams& info);
@@ -307,6 +307,7 @@ void Scanner::ScanPlainScalar() {
   params.chomp = STRIP;
   params.onDocIndicator = BREAK;
   params.onTabInIndentation = THROW;
+  params.classify = true;
 
   // insert a potential simple key
   InsertPotentialSimpleKey();
@@ -324,6 +325,7 @@ void Scanner::ScanPlainScalar() {
 
   Token token(Token::PLAIN_SCALAR, mark);
   token.value = scalar;
+  token.hint = params.hint;
   m_tokens.push(token);
 }
 
@@ -363,6 +365,7 @@ void Scanner::ScanQuotedScalar() {
 
   Token token(Token::NON_PLAIN_SCALAR, mark);
   token.value = scalar;
+  token.hint = ScalarHint::Quoted;
   m_tokens.push(token);
 }
 
@@ -414,6 +417,13 @@ void Scanner::ScanBlockScalar() {
   if (INPUT && !Exp::Break().Matches(INPUT))
     throw ParserException(INPUT.mark(), ErrorMsg::CHAR_IN_BLOCK);
 
+  // a block scalar can't be a simple key, so the indent pushed for one (by a
+  // tag or anchor before it, as in "- !!binary |") isn't its parent's
+  InvalidateSimpleKey();
+  while (!m_indents.empty() &&
+         m_indents.top()->status == IndentMarker::INVALID)
+    PopIndent();
+
   // set the initial indentation
   if (GetTopIndent() >= 0)
     params.indent += GetTopIndent();
@@ -431,6 +441,7 @@ void Scanner::ScanBlockScalar() {
 
   Token token(Token::NON_PLAIN_SCALAR, mark);
   token.value = scalar;
+  token.hint = ScalarHint::Quoted;
   m_tokens.push(token);
 }
 }
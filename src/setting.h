@@ -7,91 +7,93 @@
 #pragma once
 #endif
 
-#include <memory>
+#include <cassert>
+#include <cstddef>
 #include <vector>
-#include "yaml-cpp/noncopyable.h"
 
 namespace YAML {
-class SettingChangeBase;
+class SettingChange;
 
+// Setting
+// . One emitter setting; T must be an integer or enum type (so that a
+//   SettingChange can keep its old value in a std::size_t).
 template <typename T>
 class Setting {
  public:
   Setting() : m_value() {}
 
   const T get() const { return m_value; }
-  std::auto_ptr<SettingChangeBase> set(const T& value);
-  void restore(const Setting<T>& oldSetting) { m_value = oldSetting.get(); }
+  SettingChange set(const T& value);
+  void restore(const T& oldValue) { m_value = oldValue; }
 
  private:
   T m_value;
 };
 
-class SettingChangeBase {
+// SettingChange
+// . A setting and the value it had before it was changed; a plain value, so
+//   a list of them can live in one vector.
+class SettingChange {
  public:
-  virtual ~SettingChangeBase() {}
-  virtual void pop() = 0;
-};
+  template <typename T>
+  explicit SettingChange(Setting<T>* pSetting)
+      : m_pSetting(pSetting),
+        m_pop(&Pop<T>),
+        m_oldValue(static_cast<std::size_t>(pSetting->get())) {}
 
-template <typename T>
-class SettingChange : public SettingChangeBase {
- public:
-  SettingChange(Setting<T>* pSetting) : m_pCurSetting(pSetting) {
-    // copy old setting to save its state
-    m_oldSetting = *pSetting;
-  }
+  void pop() const { m_pop(m_pSetting, m_oldValue); }
 
-  virtual void pop() { m_pCurSetting->restore(m_oldSetting); }
+ private:
+  template <typename T>
+  static void Pop(void* pSetting, std::size_t oldValue) {
+    static_cast<Setting<T>*>(pSetting)->restore(static_cast<T>(oldValue));
+  }
 
  private:
-  Setting<T>* m_pCurSetting;
-  Setting<T> m_oldSetting;
+  void* m_pSetting;
+  void (*m_pop)(void*, std::size_t);
+  std::size_t m_oldValue;
 };
 
 template <typename T>
-inline std::auto_ptr<SettingChangeBase> Setting<T>::set(const T& value) {
-  std::auto_ptr<SettingChangeBase> pChange(new SettingChange<T>(this));
+inline SettingChange Setting<T>::set(const T& value) {
+  SettingChange change(this);
   m_value = value;
-  return pChange;
+  return change;
 }
 
-class SettingChanges : private noncopyable {
+// SettingChanges
+// . An undo log of setting changes. Nothing is undone implicitly: restore()
+//   or clear() do that, and clear() keeps the capacity for the next changes.
+class SettingChanges {
  public:
   SettingChanges() {}
-  ~SettingChanges() { clear(); }
+
+  bool empty() const { return m_settingChanges.empty(); }
 
   void clear() {
     restore();
-
-    for (setting_changes::const_iterator it = m_settingChanges.begin();
-         it != m_settingChanges.end(); ++it)
-      delete *it;
     m_settingChanges.clear();
   }
 
   void restore() {
     for (setting_changes::const_iterator it = m_settingChanges.begin();
          it != m_settingChanges.end(); ++it)
-      (*it)->pop();
+      it->pop();
   }
 
-  void push(std::auto_ptr<SettingChangeBase> pSettingChange) {
-    m_settingChanges.push_back(pSettingChange.release());
+  void push(const SettingChange& settingChange) {
+    m_settingChanges.push_back(settingChange);
   }
 
-  // like std::auto_ptr - assignment is transfer of ownership
-  SettingChanges& operator=(SettingChanges& rhs) {
-    if (this == &rhs)
-      return *this;
-
-    clear();
-    m_settingChanges = rhs.m_settingChanges;
-    rhs.m_settingChanges.clear();
-    return *this;
+  // hands these changes to rhs (which must be empty), and takes its storage
+  void transfer(SettingChanges& rhs) {
+    assert(rhs.empty());
+    m_settingChanges.swap(rhs.m_settingChanges);
   }
 
  private:
-  typedef std::vector<SettingChangeBase*> setting_changes;
+  typedef std::vector<SettingChange> setting_changes;
   setting_changes m_settingChanges;
 };
 }
@@ -89,7 +89,8 @@ void SingleDocParser::HandleNode(EventHandler& eventHandler) {
   switch (token.type) {
     case Token::PLAIN_SCALAR:
     case Token::NON_PLAIN_SCALAR:
-      eventHandler.OnScalar(mark, tag, anchor, token.value);
+      eventHandler.OnScalarWithHint(mark, tag, anchor, token.value,
+                                    token.hint);
       m_scanner.pop();
       return;
     case Token::FLOW_SEQ_START:
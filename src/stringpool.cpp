@@ -0,0 +1,58 @@
+#include "yaml-cpp/stringpool.h"
+
+namespace {
+// Hash
+// . FNV-1a.
+std::size_t Hash(const std::string& str) {
+  std::size_t hash = static_cast<std::size_t>(2166136261u);
+  for (std::size_t i = 0; i < str.size(); i++) {
+    hash ^= static_cast<unsigned char>(str[i]);
+    hash *= static_cast<std::size_t>(16777619u);
+  }
+  return hash;
+}
+}
+
+namespace YAML {
+StringPool::StringPool() : m_slots(64), m_lookups(0), m_hits(0) {}
+
+StringPool::~StringPool() {}
+
+// Intern
+// . Returns the pooled copy of 'str', adding it if it's new.
+// . The returned reference stays valid for the lifetime of the pool.
+const std::string& StringPool::Intern(const std::string& str) {
+  m_lookups++;
+  const std::size_t hash = Hash(str);
+  const std::size_t mask = m_slots.size() - 1;
+  std::size_t i = hash & mask;
+  for (; m_slots[i].pString; i = (i + 1) & mask) {
+    const Slot& slot = m_slots[i];
+    if (slot.hash == hash && *slot.pString == str) {
+      m_hits++;
+      return *slot.pString;
+    }
+  }
+
+  m_strings.push_back(str);
+  m_slots[i].pString = &m_strings.back();
+  m_slots[i].hash = hash;
+  if (2 * m_strings.size() > m_slots.size())
+    Grow();
+  return m_strings.back();
+}
+
+void StringPool::Grow() {
+  std::vector<Slot> slots(2 * m_slots.size());
+  const std::size_t mask = slots.size() - 1;
+  for (std::size_t i = 0; i < m_slots.size(); i++) {
+    if (!m_slots[i].pString)
+      continue;
+    std::size_t j = m_slots[i].hash & mask;
+    while (slots[j].pString)
+      j = (j + 1) & mask;
+    slots[j] = m_slots[i];
+  }
+  m_slots.swap(slots);
+}
+}
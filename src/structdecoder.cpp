@@ -0,0 +1,252 @@
+#include "yaml-cpp/structdecoder.h"
+
+#include <cassert>
+
+namespace {
+// Hash
+// . FNV-1a, perturbed by 'seed' (so we can search for a perfect one).
+unsigned Hash(const std::string& str, unsigned seed) {
+  unsigned hash = 2166136261u ^ seed;
+  for (std::size_t i = 0; i < str.size(); i++) {
+    hash ^= static_cast<unsigned char>(str[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+}
+
+namespace YAML {
+////////////////////////////////////////////////////////////////
+// StructTypeDecoder
+
+StructTypeDecoder::StructTypeDecoder() : m_seed(0) {}
+
+StructTypeDecoder::~StructTypeDecoder() {
+  for (std::size_t i = 0; i < m_fields.size(); i++)
+    delete m_fields[i];
+}
+
+// Add
+// . Takes ownership of 'pField'; if there's already a field with its name,
+//   the first one wins.
+void StructTypeDecoder::Add(FieldDecoder* pField) {
+  for (std::size_t i = 0; i < m_fields.size(); i++) {
+    if (m_fields[i]->name == pField->name) {
+      delete pField;
+      return;
+    }
+  }
+  m_fields.push_back(pField);
+}
+
+// Finish
+// . Searches for a seed that hashes every field to its own slot, in a
+//   table at least twice as big as the number of fields (which usually
+//   takes only a few tries).
+void StructTypeDecoder::Finish() {
+  std::size_t size = 1;
+  while (size < 2 * m_fields.size())
+    size *= 2;
+
+  for (;; size *= 2) {
+    for (unsigned seed = 0; seed < 256; seed++) {
+      if (BuildTable(size, seed))
+        return;
+    }
+  }
+}
+
+bool StructTypeDecoder::BuildTable(std::size_t size, unsigned seed) {
+  m_table.assign(size, 0);
+  m_seed = seed;
+  for (std::size_t i = 0; i < m_fields.size(); i++) {
+    const unsigned hash = Hash(m_fields[i]->name, seed);
+    const FieldDecoder*& slot = m_table[hash & (size - 1)];
+    if (slot)
+      return false;
+    slot = m_fields[i];
+  }
+  return true;
+}
+
+const FieldDecoder* StructTypeDecoder::FindField(
+    const std::string& key) const {
+  if (m_table.empty())
+    return 0;
+
+  const FieldDecoder* pField =
+      m_table[Hash(key, m_seed) & (m_table.size() - 1)];
+  return pField && pField->name == key ? pField : 0;
+}
+
+////////////////////////////////////////////////////////////////
+// StructDecoderBase
+
+StructDecoderBase::StructDecoderBase(void* pRoot,
+                                     const TypeDecoder& rootDecoder)
+    : m_root(pRoot, &rootDecoder), m_skipDepth(0), m_failed(false) {}
+
+StructDecoderBase::~StructDecoderBase() {}
+
+void StructDecoderBase::OnDocumentStart(const Mark&) {
+  m_value = m_root;
+  m_frames.clear();
+  m_skipDepth = 0;
+  m_failed = false;
+  m_failedMark = Mark();
+}
+
+void StructDecoderBase::OnDocumentEnd() {}
+
+void StructDecoderBase::OnNull(const Mark& mark, anchor_t anchor) {
+  OnScalarWithHint(mark, "", anchor, "~", ScalarHint::Null);
+}
+
+void StructDecoderBase::OnAlias(const Mark& mark, anchor_t) {
+  if (m_failed || m_skipDepth > 0)
+    return;
+
+  // we don't keep what the anchor referred to, so an aliased key can't name
+  // a field, and we skip its value
+  if (AtKey()) {
+    m_frames.back().atKey = false;
+    m_value = Target();
+  } else if (NextTarget().pDecoder) {
+    Fail(mark);
+  }
+}
+
+void StructDecoderBase::OnScalar(const Mark& mark, const std::string& tag,
+                                 anchor_t anchor, const std::string& value) {
+  OnScalarWithHint(mark, tag, anchor, value, ScalarHint::Unknown);
+}
+
+void StructDecoderBase::OnScalarWithHint(const Mark& mark,
+                                         const std::string&, anchor_t,
+                                         const std::string& value,
+                                         ScalarHint::value hint) {
+  if (m_failed || m_skipDepth > 0)
+    return;
+
+  if (AtKey()) {
+    Frame& frame = m_frames.back();
+    frame.atKey = false;
+    if (const FieldDecoder* pField = frame.target.pDecoder->FindField(value))
+      m_value = Target(pField->Member(frame.target.pObject), &pField->decoder);
+    else
+      m_value = Target();
+    return;
+  }
+
+  Target target = NextTarget();
+  if (!target.pDecoder)
+    return;
+
+  // a null leaves a struct or sequence as it is
+  if (target.pDecoder->kind() != TypeDecoder::Kind::Scalar) {
+    if (ClassifyKeyword(value.data(), value.size()) != ScalarKeyword::Null)
+      Fail(mark);
+    return;
+  }
+
+  if (!target.pDecoder->DecodeScalar(target.pObject, value, hint))
+    Fail(mark);
+}
+
+void StructDecoderBase::OnSequenceStart(const Mark& mark, const std::string&,
+                                        anchor_t, EmitterStyle::value) {
+  BeginCollection(mark, TypeDecoder::Kind::Sequence);
+}
+
+void StructDecoderBase::OnSequenceEnd() { EndCollection(); }
+
+void StructDecoderBase::OnMapStart(const Mark& mark, const std::string&,
+                                   anchor_t, EmitterStyle::value) {
+  BeginCollection(mark, TypeDecoder::Kind::Struct);
+}
+
+void StructDecoderBase::OnMapEnd() { EndCollection(); }
+
+// AtKey
+// . Returns true if the next node is a key of the struct we're in.
+bool StructDecoderBase::AtKey() const {
+  return !m_frames.empty() && m_frames.back().atKey;
+}
+
+// NextTarget
+// . Returns what the next (non-key) node decodes into, moving on to the
+//   following node.
+StructDecoderBase::Target StructDecoderBase::NextTarget() {
+  if (m_frames.empty()) {
+    Target target = m_value;
+    m_value = Target();
+    return target;
+  }
+
+  Frame& frame = m_frames.back();
+  switch (frame.target.pDecoder->kind()) {
+    case TypeDecoder::Kind::Struct:
+      frame.atKey = true;
+      return m_value;
+    case TypeDecoder::Kind::Sequence: {
+      Target element;
+      element.pObject =
+          frame.target.pDecoder->Append(frame.target.pObject, element.pDecoder);
+      return element;
+    }
+    case TypeDecoder::Kind::Scalar:
+      break;
+  }
+
+  assert(false);
+  return Target();
+}
+
+void StructDecoderBase::BeginCollection(const Mark& mark,
+                                        TypeDecoder::Kind::value kind) {
+  if (m_failed)
+    return;
+
+  if (m_skipDepth > 0) {
+    m_skipDepth++;
+    return;
+  }
+
+  // a collection key can't name a field, so we skip its value too
+  if (AtKey()) {
+    m_frames.back().atKey = false;
+    m_value = Target();
+    m_skipDepth = 1;
+    return;
+  }
+
+  Target target = NextTarget();
+  if (!target.pDecoder || target.pDecoder->kind() != kind) {
+    if (target.pDecoder)
+      Fail(mark);
+    m_skipDepth = 1;
+    return;
+  }
+
+  target.pDecoder->Clear(target.pObject);
+  Frame frame;
+  frame.target = target;
+  frame.atKey = kind == TypeDecoder::Kind::Struct;
+  m_frames.push_back(frame);
+}
+
+void StructDecoderBase::EndCollection() {
+  if (m_failed)
+    return;
+
+  if (m_skipDepth > 0)
+    m_skipDepth--;
+  else
+    m_frames.pop_back();
+}
+
+void StructDecoderBase::Fail(const Mark& mark) {
+  m_failed = true;
+  m_failedMark = mark;
+}
+}
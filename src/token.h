@@ -8,6 +8,7 @@
 #endif
 
 #include "yaml-cpp/mark.h"
+#include "yaml-cpp/scalarhint.h"
 #include <iostream>
 #include <string>
 #include <vector>
@@ -49,7 +50,11 @@ struct Token {
 
   // data
   Token(TYPE type_, const Mark& mark_)
-      : status(VALID), type(type_), mark(mark_), data(0) {}
+      : status(VALID),
+        type(type_),
+        mark(mark_),
+        data(0),
+        hint(ScalarHint::Unknown) {}
 
   friend std::ostream& operator<<(std::ostream& out, const Token& token) {
     out << TokenNames[token.type] << std::string(": ") << token.value;
@@ -64,6 +69,7 @@ struct Token {
   std::string value;
   std::vector<std::string> params;
   int data;
+  ScalarHint::value hint;  // for scalars
 };
 }
 
@@ -0,0 +1,283 @@
+#include "yaml-cpp/transcode.h"
+
+#include <map>
+#include <ostream>
+#include <vector>
+
+#include "yaml-cpp/conversion.h"
+#include "yaml-cpp/emitfromevents.h"
+#include "yaml-cpp/emitter.h"
+#include "yaml-cpp/eventhandler.h"
+#include "yaml-cpp/exceptions.h"
+#include "yaml-cpp/jsonemitter.h"
+#include "yaml-cpp/null.h"
+#include "yaml-cpp/parser.h"
+
+namespace {
+// a plain scalar that reads as a number, bool or null
+bool IsTypedPlain(const std::string& tag, YAML::ScalarHint::value hint) {
+  if (tag != "?")
+    return false;
+  switch (hint) {
+    case YAML::ScalarHint::Null:
+    case YAML::ScalarHint::Bool:
+    case YAML::ScalarHint::Int:
+    case YAML::ScalarHint::Float:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// separates the documents it emits, and keeps typed plain scalars plain
+class TranscodeHandler : public YAML::EmitFromEvents {
+ public:
+  TranscodeHandler(YAML::Emitter& emitter,
+                   const YAML::TranscodeOptions& options)
+      : YAML::EmitFromEvents(emitter, options.style),
+        m_emitter(emitter),
+        m_quoteStrings(options.stringFormat != YAML::Auto),
+        m_documents(0) {}
+
+  std::size_t documents() const { return m_documents; }
+
+  virtual void OnDocumentStart(const YAML::Mark& mark) {
+    if (m_documents > 0)
+      m_emitter << YAML::BeginDoc;
+    m_documents++;
+    YAML::EmitFromEvents::OnDocumentStart(mark);
+  }
+
+  virtual void OnScalarWithHint(const YAML::Mark& mark, const std::string& tag,
+                                YAML::anchor_t anchor, const std::string& value,
+                                YAML::ScalarHint::value hint) {
+    if (m_quoteStrings && IsTypedPlain(tag, hint))
+      m_emitter << YAML::Auto;
+    OnScalar(mark, tag, anchor, value);
+  }
+
+ private:
+  YAML::Emitter& m_emitter;
+  bool m_quoteStrings;
+  std::size_t m_documents;
+};
+
+// writes the events as JSON; an anchored node's events are recorded as
+// they go by, and an alias plays them again
+class JsonHandler : public YAML::EventHandler {
+ public:
+  explicit JsonHandler(YAML::JsonEmitter& emitter)
+      : m_emitter(emitter), m_depth(0), m_documents(0) {}
+
+  std::size_t documents() const { return m_documents; }
+
+  virtual void OnDocumentStart(const YAML::Mark&) { m_documents++; }
+  virtual void OnDocumentEnd() { m_anchored.clear(); }
+
+  virtual void OnNull(const YAML::Mark&, YAML::anchor_t anchor) {
+    Begin(anchor);
+    Write(Event(Event::NULL_VALUE));
+  }
+
+  virtual void OnAlias(const YAML::Mark&, YAML::anchor_t anchor) {
+    std::map<YAML::anchor_t, std::vector<Event> >::const_iterator it =
+        m_anchored.find(anchor);
+    if (it == m_anchored.end()) {
+      Write(Event(Event::NULL_VALUE));
+      return;
+    }
+
+    // a copy, since the node may be recorded again inside another anchor
+    const std::vector<Event> events = it->second;
+    for (std::size_t i = 0; i < events.size(); i++)
+      Write(events[i]);
+  }
+
+  virtual void OnScalar(const YAML::Mark& mark, const std::string& tag,
+                        YAML::anchor_t anchor, const std::string& value) {
+    OnScalarWithHint(mark, tag, anchor, value, YAML::ScalarHint::Unknown);
+  }
+
+  virtual void OnScalarWithHint(const YAML::Mark&, const std::string& tag,
+                                YAML::anchor_t anchor, const std::string& value,
+                                YAML::ScalarHint::value hint) {
+    Begin(anchor);
+    Event event(Event::SCALAR);
+    event.value = value;
+    event.hint = IsTypedPlain(tag, hint) ? hint : YAML::ScalarHint::String;
+    Write(event);
+  }
+
+  virtual void OnSequenceStart(const YAML::Mark&, const std::string&,
+                               YAML::anchor_t anchor,
+                               YAML::EmitterStyle::value) {
+    Begin(anchor);
+    Write(Event(Event::SEQ_START));
+  }
+  virtual void OnSequenceEnd() { Write(Event(Event::SEQ_END)); }
+
+  virtual void OnMapStart(const YAML::Mark&, const std::string&,
+                          YAML::anchor_t anchor, YAML::EmitterStyle::value) {
+    Begin(anchor);
+    Write(Event(Event::MAP_START));
+  }
+  virtual void OnMapEnd() { Write(Event(Event::MAP_END)); }
+
+ private:
+  struct Event {
+    enum TYPE { NULL_VALUE, SCALAR, SEQ_START, SEQ_END, MAP_START, MAP_END };
+
+    explicit Event(TYPE type_) : type(type_), hint(YAML::ScalarHint::Unknown) {}
+
+    TYPE type;
+    std::string value;
+    YAML::ScalarHint::value hint;
+  };
+
+  // an anchored node being recorded, and the depth it started at
+  struct Recording {
+    YAML::anchor_t anchor;
+    std::size_t depth;
+  };
+
+  void Begin(YAML::anchor_t anchor) {
+    if (!anchor)
+      return;
+    m_anchored[anchor].clear();
+    Recording recording = {anchor, m_depth};
+    m_recordings.push_back(recording);
+  }
+
+  void Write(const Event& event) {
+    for (std::size_t i = 0; i < m_recordings.size(); i++)
+      m_anchored[m_recordings[i].anchor].push_back(event);
+
+    switch (event.type) {
+      case Event::NULL_VALUE:
+        m_emitter << YAML::Null;
+        break;
+      case Event::SCALAR:
+        WriteScalar(event.value, event.hint);
+        break;
+      case Event::SEQ_START:
+        m_emitter << YAML::BeginSeq;
+        m_depth++;
+        break;
+      case Event::SEQ_END:
+        m_emitter << YAML::EndSeq;
+        m_depth--;
+        break;
+      case Event::MAP_START:
+        m_emitter << YAML::BeginMap;
+        m_depth++;
+        break;
+      case Event::MAP_END:
+        m_emitter << YAML::EndMap;
+        m_depth--;
+        break;
+    }
+
+    // the nodes this finished
+    while (!m_recordings.empty() && m_recordings.back().depth == m_depth)
+      m_recordings.pop_back();
+  }
+
+  // a number that won't convert (say, one that's out of range) is kept as a
+  // string
+  void WriteScalar(const std::string& value, YAML::ScalarHint::value hint) {
+    switch (hint) {
+      case YAML::ScalarHint::Null:
+        m_emitter << YAML::Null;
+        return;
+      case YAML::ScalarHint::Bool: {
+        bool b = false;
+        if (YAML::Convert(value, b)) {
+          m_emitter << b;
+          return;
+        }
+        break;
+      }
+      case YAML::ScalarHint::Int: {
+        long long i = 0;
+        unsigned long long u = 0;
+        if (YAML::Convert(value, i)) {
+          m_emitter << i;
+          return;
+        }
+        if (YAML::Convert(value, u)) {
+          m_emitter << u;
+          return;
+        }
+        // too big for an integer, but still a number
+        double d = 0;
+        if (YAML::Convert(value, d)) {
+          m_emitter << d;
+          return;
+        }
+        break;
+      }
+      case YAML::ScalarHint::Float: {
+        double d = 0;
+        if (YAML::Convert(value, d)) {
+          m_emitter << d;
+          return;
+        }
+        break;
+      }
+      default:
+        break;
+    }
+    m_emitter << value;
+  }
+
+ private:
+  YAML::JsonEmitter& m_emitter;
+  std::map<YAML::anchor_t, std::vector<Event> > m_anchored;
+  std::vector<Recording> m_recordings;
+  std::size_t m_depth;
+  std::size_t m_documents;
+};
+}
+
+namespace YAML {
+std::size_t Transcode(std::istream& input, std::ostream& output,
+                      const TranscodeOptions& options) {
+  std::size_t documents = 0;
+  if (options.json) {
+    JsonEmitter emitter(output);
+    documents = Transcode(input, emitter);
+  } else {
+    Emitter emitter(output);
+    documents = Transcode(input, emitter, options);
+  }
+  if (documents > 0)
+    output << "\n";
+  return documents;
+}
+
+std::size_t Transcode(std::istream& input, Emitter& emitter,
+                      const TranscodeOptions& options) {
+  if (!emitter.SetIndent(options.indent))
+    throw EmitterException(ErrorMsg::INVALID_INDENT);
+  if (!emitter.SetStringFormat(options.stringFormat))
+    throw EmitterException(ErrorMsg::INVALID_STRING_FORMAT);
+
+  Parser parser(input);
+  TranscodeHandler handler(emitter, options);
+  while (parser.HandleNextDocument(handler)) {
+    if (!emitter.good())
+      throw EmitterException(emitter.GetLastError());
+  }
+  return handler.documents();
+}
+
+std::size_t Transcode(std::istream& input, JsonEmitter& emitter) {
+  Parser parser(input);
+  JsonHandler handler(emitter);
+  while (parser.HandleNextDocument(handler)) {
+    if (!emitter.good())
+      throw EmitterException(emitter.GetLastError());
+  }
+  return handler.documents();
+}
+}
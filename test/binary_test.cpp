@@ -0,0 +1,199 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "yaml-cpp/binary.h"
+
+namespace {
+std::vector<unsigned char> Bytes(const std::string& text) {
+  return std::vector<unsigned char>(text.begin(), text.end());
+}
+
+// deterministic, but with every byte value
+std::vector<unsigned char> Pattern(std::size_t size) {
+  std::vector<unsigned char> bytes(size);
+  for (std::size_t i = 0; i < size; i++)
+    bytes[i] = static_cast<unsigned char>(i * 2654435761u >> 13);
+  return bytes;
+}
+
+std::string Encode(const std::vector<unsigned char>& bytes) {
+  return YAML::EncodeBase64(bytes.empty() ? 0 : &bytes[0], bytes.size());
+}
+
+TEST(BinaryTest, EncodeKnownValues) {
+  // RFC 4648, section 10
+  EXPECT_EQ("", Encode(Bytes("")));
+  EXPECT_EQ("Zg==", Encode(Bytes("f")));
+  EXPECT_EQ("Zm8=", Encode(Bytes("fo")));
+  EXPECT_EQ("Zm9v", Encode(Bytes("foo")));
+  EXPECT_EQ("Zm9vYg==", Encode(Bytes("foob")));
+  EXPECT_EQ("Zm9vYmE=", Encode(Bytes("fooba")));
+  EXPECT_EQ("Zm9vYmFy", Encode(Bytes("foobar")));
+
+  const unsigned char high[] = {0xfb, 0xff, 0xbf};
+  EXPECT_EQ("+/+/", YAML::EncodeBase64(high, 3));
+}
+
+TEST(BinaryTest, DecodeKnownValues) {
+  EXPECT_EQ(Bytes(""), YAML::DecodeBase64(""));
+  EXPECT_EQ(Bytes("f"), YAML::DecodeBase64("Zg=="));
+  EXPECT_EQ(Bytes("fo"), YAML::DecodeBase64("Zm8="));
+  EXPECT_EQ(Bytes("foo"), YAML::DecodeBase64("Zm9v"));
+  EXPECT_EQ(Bytes("foobar"), YAML::DecodeBase64("Zm9vYmFy"));
+  EXPECT_EQ(Bytes("fooba"), YAML::DecodeBase64("Zm9vYmE="));
+}
+
+TEST(BinaryTest, DecodeRejectsOtherCharacters) {
+  EXPECT_TRUE(YAML::DecodeBase64("Zm9v!mFy").empty());
+  EXPECT_TRUE(YAML::DecodeBase64("Zm9vYmF\xC3").empty());
+}
+
+TEST(BinaryTest, DecodeSkipsWhitespace) {
+  EXPECT_EQ(Bytes("foobar"), YAML::DecodeBase64("Zm9v\nYmFy"));
+  EXPECT_EQ(Bytes("foobar"), YAML::DecodeBase64(" Zm 9vY\r\n\tmFy\n"));
+  EXPECT_EQ(Bytes("fooba"), YAML::DecodeBase64("Zm9v\n  YmE=\n"));
+}
+
+TEST(BinaryTest, DecodeIntoBuffer) {
+  const std::string input = "Zm9v\nYmE=";
+  unsigned char output[12];
+  YAML::Base64Decoder decoder;
+  ASSERT_GE(sizeof(output), YAML::Base64Decoder::MaxDecodedSize(9));
+  EXPECT_EQ(0u, decoder.Decode(input.data(), 3, output));
+  EXPECT_EQ(3u, decoder.Decode(input.data() + 3, 3, output));
+  EXPECT_EQ(2u, decoder.Decode(input.data() + 6, 3, output + 3));
+  EXPECT_EQ(Bytes("fooba"), std::vector<unsigned char>(output, output + 5));
+}
+
+TEST(BinaryTest, RoundTrip) {
+  for (std::size_t size = 0; size < 100; size++) {
+    const std::vector<unsigned char> bytes = Pattern(size);
+    EXPECT_EQ(bytes, YAML::DecodeBase64(Encode(bytes))) << size;
+  }
+}
+
+TEST(BinaryTest, EncoderInChunks) {
+  const std::vector<unsigned char> bytes = Pattern(40);
+  const std::string expected = Encode(bytes);
+
+  for (std::size_t first = 0; first <= bytes.size(); first++) {
+    for (std::size_t second = first; second <= bytes.size(); second++) {
+      YAML::Base64Encoder encoder;
+      std::string output;
+      encoder.Encode(&bytes[0], first, output);
+      encoder.Encode(&bytes[0] + first, second - first, output);
+      encoder.Encode(&bytes[0] + second, bytes.size() - second, output);
+      encoder.Finish(output);
+      EXPECT_EQ(expected, output) << first << ", " << second;
+    }
+  }
+}
+
+TEST(BinaryTest, DecoderInChunks) {
+  const std::vector<unsigned char> bytes = Pattern(28);
+  const std::string input = Encode(bytes);
+
+  for (std::size_t first = 0; first <= input.size(); first++) {
+    for (std::size_t second = first; second <= input.size(); second++) {
+      YAML::Base64Decoder decoder;
+      std::vector<unsigned char> output;
+      EXPECT_TRUE(decoder.Decode(input.data(), first, output));
+      EXPECT_TRUE(decoder.Decode(input.data() + first, second - first, output));
+      EXPECT_TRUE(decoder.Decode(input.data() + second, input.size() - second,
+                                 output));
+      EXPECT_EQ(bytes, output) << first << ", " << second;
+    }
+  }
+}
+
+TEST(BinaryTest, DecoderStaysFailed) {
+  YAML::Base64Decoder decoder;
+  std::vector<unsigned char> output;
+  EXPECT_TRUE(decoder.Decode("Zm9v", 4, output));
+  EXPECT_FALSE(decoder.Decode("Ym?y", 4, output));
+  EXPECT_TRUE(decoder.failed());
+  EXPECT_FALSE(decoder.Decode("Zm9v", 4, output));
+  EXPECT_EQ(Bytes("foo"), output);
+
+  decoder.Reset();
+  EXPECT_TRUE(decoder.Decode("YmFy", 4, output));
+  EXPECT_EQ(Bytes("foobar"), output);
+}
+
+// the kernels this CPU runs besides the tables
+std::vector<YAML::Base64Kernel::value> SimdKernels() {
+  const YAML::Base64Kernel::value current = YAML::GetBase64Kernel();
+  std::vector<YAML::Base64Kernel::value> kernels;
+  if (YAML::SetBase64Kernel(YAML::Base64Kernel::Ssse3))
+    kernels.push_back(YAML::Base64Kernel::Ssse3);
+  if (YAML::SetBase64Kernel(YAML::Base64Kernel::Avx2))
+    kernels.push_back(YAML::Base64Kernel::Avx2);
+  YAML::SetBase64Kernel(current);
+  return kernels;
+}
+
+TEST(BinaryTest, SimdKernelsEncodeLikeTables) {
+  const YAML::Base64Kernel::value current = YAML::GetBase64Kernel();
+  const std::vector<YAML::Base64Kernel::value> kernels = SimdKernels();
+
+  for (std::size_t size = 0; size < 300; size += (size < 100 ? 1 : 37)) {
+    const std::vector<unsigned char> bytes = Pattern(size);
+    ASSERT_TRUE(YAML::SetBase64Kernel(YAML::Base64Kernel::Tables));
+    const std::string expected = Encode(bytes);
+
+    for (std::size_t i = 0; i < kernels.size(); i++) {
+      ASSERT_TRUE(YAML::SetBase64Kernel(kernels[i]));
+      EXPECT_EQ(expected, Encode(bytes)) << kernels[i] << ", " << size;
+      EXPECT_EQ(bytes, YAML::DecodeBase64(expected)) << kernels[i] << ", "
+                                                     << size;
+    }
+  }
+  EXPECT_TRUE(YAML::SetBase64Kernel(current));
+}
+
+TEST(BinaryTest, SimdKernelsDecodeLikeTables) {
+  const YAML::Base64Kernel::value current = YAML::GetBase64Kernel();
+  const std::vector<YAML::Base64Kernel::value> kernels = SimdKernels();
+
+  // every byte at every position of two AVX2 blocks: whitespace is skipped,
+  // padding ends the data, and anything else fails
+  const std::string valid = Encode(Pattern(48));
+  for (std::size_t pos = 0; pos < valid.size(); pos++) {
+    for (unsigned ch = 0; ch < 256; ch++) {
+      std::string input = valid;
+      input[pos] = static_cast<char>(ch);
+      ASSERT_TRUE(YAML::SetBase64Kernel(YAML::Base64Kernel::Tables));
+      const std::vector<unsigned char> expected = YAML::DecodeBase64(input);
+
+      for (std::size_t i = 0; i < kernels.size(); i++) {
+        ASSERT_TRUE(YAML::SetBase64Kernel(kernels[i]));
+        EXPECT_EQ(expected, YAML::DecodeBase64(input))
+            << kernels[i] << ", " << pos << ", " << ch;
+      }
+    }
+  }
+  EXPECT_TRUE(YAML::SetBase64Kernel(current));
+}
+
+TEST(BinaryTest, SimdKernelsDecodeIntoExactBuffer) {
+  const YAML::Base64Kernel::value current = YAML::GetBase64Kernel();
+  const std::vector<YAML::Base64Kernel::value> kernels = SimdKernels();
+
+  // the output is exactly as big as the data, so a kernel that writes past
+  // it would show up under a memory checker, or as a changed guard byte
+  const std::vector<unsigned char> bytes = Pattern(96);
+  const std::string input = Encode(bytes);
+  for (std::size_t i = 0; i < kernels.size(); i++) {
+    ASSERT_TRUE(YAML::SetBase64Kernel(kernels[i]));
+    std::vector<unsigned char> output(bytes.size() + 1, 0xa5);
+    YAML::Base64Decoder decoder;
+    EXPECT_EQ(bytes.size(),
+              decoder.Decode(input.data(), input.size(), &output[0]));
+    EXPECT_EQ(0xa5, output.back()) << kernels[i];
+    output.pop_back();
+    EXPECT_EQ(bytes, output) << kernels[i];
+  }
+  EXPECT_TRUE(YAML::SetBase64Kernel(current));
+}
+}
@@ -0,0 +1,236 @@
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "yaml-cpp/conversion.h"
+#include "yaml-cpp/null.h"
+#include "yaml-cpp/scalarhint.h"
+
+namespace {
+// the stream extraction Convert used to do
+template <typename T>
+bool StreamConvert(const std::string& input, T& output) {
+  std::stringstream stream(input);
+  stream.unsetf(std::ios::dec);
+  return (stream >> output) && (stream >> std::ws).eof();
+}
+
+template <typename T>
+void ExpectSameAsStream(const std::string& input) {
+  T expected = T(), actual = T();
+  bool expectedOk = StreamConvert(input, expected);
+  bool actualOk = YAML::Convert(input, actual);
+  EXPECT_EQ(expectedOk, actualOk) << "'" << input << "'";
+  if (expectedOk && actualOk) {
+    EXPECT_EQ(expected, actual) << "'" << input << "'";
+  }
+}
+
+const char* const integers[] = {
+    "0", "1", "-1", "+7", "42", " 42", "42 ", "\t42\n", "017", "-017", "08",
+    "0x1F", "0X1f", "-0x10", "0x", "0xg", "00", "", " ", "-", "+", "+-1",
+    "1.0", "1e3", "12abc", "abc", "32767", "32768", "-32768", "-32769",
+    "65535", "65536", "2147483647", "2147483648", "-2147483648",
+    "-2147483649", "4294967295", "4294967296", "9223372036854775807",
+    "9223372036854775808", "-9223372036854775808", "-9223372036854775809",
+    "18446744073709551615", "18446744073709551616", "0xFFFFFFFFFFFFFFFF",
+    "0x10000000000000000", "99999999999999999999999"};
+
+const char* const floats[] = {
+    "0", "-0", "1", "-1", "+1.5", "1.", ".5", "-.5", ".", "-", "1e10",
+    "1E-10", "1e", "1e+", "1e-", "1.5e+3", " 2.25", "2.25 ", "1.2.3",
+    "0.1", "0.2", "0.3", "3.141592653589793", "2.718281828459045235360287",
+    "1e22", "1e23", "9007199254740993", "123456789012345678901234567890",
+    "1e308", "1.7976931348623157e308", "1e400", "-1e400", "1e-300",
+    "4.9e-324", "1e-400", "0.000000000000000000000000000001",
+    "0x10", "1,5", "nan", "inf", "1.5f", "00001.2500000", "1e-22", "8e-23",
+    "3.4028235e38", "3.4028236e38", "1.17549435e-38", "16777217"};
+
+TEST(ConversionTest, IntegersMatchStreamExtraction) {
+  for (std::size_t i = 0; i < sizeof(integers) / sizeof(integers[0]); i++) {
+    ExpectSameAsStream<short>(integers[i]);
+    ExpectSameAsStream<unsigned short>(integers[i]);
+    ExpectSameAsStream<int>(integers[i]);
+    ExpectSameAsStream<unsigned>(integers[i]);
+    ExpectSameAsStream<long>(integers[i]);
+    ExpectSameAsStream<long long>(integers[i]);
+    ExpectSameAsStream<unsigned long long>(integers[i]);
+  }
+}
+
+TEST(ConversionTest, FloatsMatchStreamExtraction) {
+  for (std::size_t i = 0; i < sizeof(floats) / sizeof(floats[0]); i++) {
+    ExpectSameAsStream<float>(floats[i]);
+    ExpectSameAsStream<double>(floats[i]);
+  }
+}
+
+TEST(ConversionTest, RandomFloatsAreCorrectlyRounded) {
+  std::srand(1234);
+  for (int i = 0; i < 10000; i++) {
+    std::stringstream stream;
+    stream << std::rand() % 100000;
+    if (i % 2)
+      stream << "." << std::rand() % 100000;
+    if (i % 3)
+      stream << "e" << std::rand() % 40 - 20;
+    ExpectSameAsStream<float>(stream.str());
+    ExpectSameAsStream<double>(stream.str());
+  }
+}
+
+TEST(ConversionTest, OctalWithPrefix) {
+  int value = 0;
+  EXPECT_TRUE(YAML::Convert("0o17", value));
+  EXPECT_EQ(15, value);
+  EXPECT_TRUE(YAML::Convert("-0o17", value));
+  EXPECT_EQ(-15, value);
+  EXPECT_FALSE(YAML::Convert("0o8", value));
+  EXPECT_FALSE(YAML::Convert("0o", value));
+}
+
+TEST(ConversionTest, InfinityAndNaN) {
+  double value = 0;
+  EXPECT_TRUE(YAML::Convert(".inf", value));
+  EXPECT_EQ(std::numeric_limits<double>::infinity(), value);
+  EXPECT_TRUE(YAML::Convert("-.Inf", value));
+  EXPECT_EQ(-std::numeric_limits<double>::infinity(), value);
+  EXPECT_TRUE(YAML::Convert(".NaN", value));
+  EXPECT_NE(value, value);
+
+  int integer = 0;
+  EXPECT_FALSE(YAML::Convert(".inf", integer));
+}
+
+TEST(ConversionTest, CharsReadOneCharacter) {
+  char ch = 0;
+  EXPECT_TRUE(YAML::Convert("a", ch));
+  EXPECT_EQ('a', ch);
+  EXPECT_FALSE(YAML::Convert("ab", ch));
+
+  long double value = 0;
+  EXPECT_TRUE(YAML::Convert("0.5", value));
+  EXPECT_EQ(0.5L, value);
+}
+
+TEST(ConversionTest, KeywordsInEveryCase) {
+  const struct {
+    const char* keyword;
+    YAML::ScalarKeyword::value meaning;
+  } keywords[] = {{"y", YAML::ScalarKeyword::True},
+                  {"yes", YAML::ScalarKeyword::True},
+                  {"true", YAML::ScalarKeyword::True},
+                  {"on", YAML::ScalarKeyword::True},
+                  {"n", YAML::ScalarKeyword::False},
+                  {"no", YAML::ScalarKeyword::False},
+                  {"false", YAML::ScalarKeyword::False},
+                  {"off", YAML::ScalarKeyword::False},
+                  {"null", YAML::ScalarKeyword::Null}};
+
+  for (std::size_t i = 0; i < sizeof(keywords) / sizeof(keywords[0]); i++) {
+    const std::string keyword = keywords[i].keyword;
+    const std::size_t size = keyword.size();
+
+    // every mix of cases; only lowercase, UPPERCASE and Capitalized count
+    for (unsigned mask = 0; mask < (1u << size); mask++) {
+      std::string input = keyword;
+      for (std::size_t j = 0; j < size; j++) {
+        if (mask & (1u << j))
+          input[j] = input[j] - 'a' + 'A';
+      }
+      const unsigned all = (1u << size) - 1;
+      const bool accepted = mask == 0 || mask == 1 || mask == all;
+
+      EXPECT_EQ(accepted ? keywords[i].meaning : YAML::ScalarKeyword::None,
+                YAML::ClassifyKeyword(input.data(), input.size()))
+          << "'" << input << "'";
+
+      bool b = false;
+      EXPECT_EQ(accepted && keywords[i].meaning != YAML::ScalarKeyword::Null,
+                YAML::Convert(input, b));
+      YAML::_Null null;
+      EXPECT_EQ(accepted && keywords[i].meaning == YAML::ScalarKeyword::Null,
+                YAML::Convert(input, null));
+    }
+  }
+
+  const char* const others[] = {"yess", "nope", "tru", "of", "o", "t",
+                                "f",    "ye",   "nul", "~~", " y", "y "};
+  for (std::size_t i = 0; i < sizeof(others) / sizeof(others[0]); i++) {
+    EXPECT_EQ(YAML::ScalarKeyword::None,
+              YAML::ClassifyKeyword(others[i], std::strlen(others[i])))
+        << "'" << others[i] << "'";
+  }
+  EXPECT_EQ(YAML::ScalarKeyword::Null, YAML::ClassifyKeyword("~", 1));
+  EXPECT_EQ(YAML::ScalarKeyword::Null, YAML::ClassifyKeyword("", 0));
+}
+
+template <typename T>
+void ExpectHintAgrees(const std::string& input) {
+  YAML::ScalarHint::value hint =
+      YAML::ClassifyPlainScalar(input.data(), input.size());
+  T value = T();
+  if (!YAML::CanConvert(hint, value)) {
+    EXPECT_FALSE(YAML::Convert(input, value)) << "'" << input << "'";
+  }
+}
+
+TEST(ConversionTest, ClassifyPlainScalar) {
+  const struct {
+    const char* scalar;
+    YAML::ScalarHint::value hint;
+  } scalars[] = {{"~", YAML::ScalarHint::Null},
+                 {"null", YAML::ScalarHint::Null},
+                 {"Yes", YAML::ScalarHint::Bool},
+                 {"off", YAML::ScalarHint::Bool},
+                 {"42", YAML::ScalarHint::Int},
+                 {"-0x1F", YAML::ScalarHint::Int},
+                 {"0o17", YAML::ScalarHint::Int},
+                 {"99999999999999999999", YAML::ScalarHint::Int},
+                 {"1.5", YAML::ScalarHint::Float},
+                 {"-1e3", YAML::ScalarHint::Float},
+                 {".inf", YAML::ScalarHint::Float},
+                 {".NaN", YAML::ScalarHint::Float},
+                 {"1e400", YAML::ScalarHint::Float},
+                 {" 42 ", YAML::ScalarHint::Int},
+                 {"1.", YAML::ScalarHint::Float},
+                 {".5e-3", YAML::ScalarHint::Float},
+                 {"+.inf", YAML::ScalarHint::Float},
+                 {".", YAML::ScalarHint::String},
+                 {"1e", YAML::ScalarHint::String},
+                 {"0x ", YAML::ScalarHint::String},
+                 {"4 2", YAML::ScalarHint::String},
+                 {"08", YAML::ScalarHint::Float},
+                 {"0x", YAML::ScalarHint::String},
+                 {"1.2.3", YAML::ScalarHint::String},
+                 {"-", YAML::ScalarHint::String},
+                 {"yess", YAML::ScalarHint::String},
+                 {"hello world", YAML::ScalarHint::String}};
+
+  for (std::size_t i = 0; i < sizeof(scalars) / sizeof(scalars[0]); i++) {
+    const std::string scalar = scalars[i].scalar;
+    EXPECT_EQ(scalars[i].hint,
+              YAML::ClassifyPlainScalar(scalar.data(), scalar.size()))
+        << "'" << scalar << "'";
+  }
+
+  // a hint only rules out conversions that would fail anyway
+  for (std::size_t i = 0; i < sizeof(integers) / sizeof(integers[0]); i++) {
+    if (!*integers[i])
+      continue;
+    ExpectHintAgrees<int>(integers[i]);
+    ExpectHintAgrees<unsigned long long>(integers[i]);
+    ExpectHintAgrees<double>(integers[i]);
+    ExpectHintAgrees<bool>(integers[i]);
+  }
+  for (std::size_t i = 0; i < sizeof(floats) / sizeof(floats[0]); i++) {
+    ExpectHintAgrees<long>(floats[i]);
+    ExpectHintAgrees<float>(floats[i]);
+    ExpectHintAgrees<double>(floats[i]);
+    ExpectHintAgrees<YAML::_Null>(floats[i]);
+  }
+}
+}
@@ -1,3 +1,9 @@
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include "yaml-cpp/emitterstyle.h"
 #include "yaml-cpp/eventhandler.h"
 #include "yaml-cpp/yaml.h"  // IWYU pragma: keep
@@ -509,6 +515,89 @@ TEST_F(EmitterTest, STLContainers) {
   ExpectEmit("- [2, 3, 5, 7, 11, 13]\n- Daniel: 26\n  Jesse: 24");
 }
 
+// writes 'values' (in the places a sequence can be) with EmitSeq, or an
+// element at a time
+template <typename T>
+std::string EmitNumbers(const std::vector<T>& values, bool bulk) {
+  Emitter out;
+  out << BeginMap;
+  out << Key << "block" << Value;
+  if (bulk) {
+    EmitSeq(out, values);
+  } else {
+    out << BeginSeq;
+    for (std::size_t i = 0; i < values.size(); i++)
+      out << values[i];
+    out << EndSeq;
+  }
+  out << Key << "nested" << Value << BeginSeq << Indent(4);
+  if (bulk) {
+    EmitSeq(out, values);
+  } else {
+    out << BeginSeq;
+    for (std::size_t i = 0; i < values.size(); i++)
+      out << values[i];
+    out << EndSeq;
+  }
+  out << Flow << Hex;
+  if (bulk) {
+    EmitSeq(out, values);
+  } else {
+    out << BeginSeq;
+    for (std::size_t i = 0; i < values.size(); i++)
+      out << values[i];
+    out << EndSeq;
+  }
+  out << EndSeq << EndMap;
+  return out.c_str();
+}
+
+TEST_F(EmitterTest, NumberSeqsMatchElementByElement) {
+  std::vector<int> integers;
+  std::vector<unsigned long long> large;
+  std::vector<double> doubles;
+  std::vector<float> floats;
+  for (int i = 0; i < 2000; i++) {
+    integers.push_back((i - 1000) * 12345);
+    large.push_back(18446744073709551615ULL / (i + 1));
+    doubles.push_back((i - 1000) / 7.0);
+    floats.push_back(static_cast<float>(i) / 3);
+  }
+
+  for (std::size_t size = 0; size <= 3; size++) {
+    std::vector<int> prefix(integers.begin(), integers.begin() + size);
+    EXPECT_EQ(EmitNumbers(prefix, false), EmitNumbers(prefix, true));
+  }
+  EXPECT_EQ(EmitNumbers(integers, false), EmitNumbers(integers, true));
+  EXPECT_EQ(EmitNumbers(large, false), EmitNumbers(large, true));
+  EXPECT_EQ(EmitNumbers(doubles, false), EmitNumbers(doubles, true));
+  EXPECT_EQ(EmitNumbers(floats, false), EmitNumbers(floats, true));
+}
+
+TEST_F(EmitterTest, NumberSeqs) {
+  const int values[] = {1, -2, 3};
+  const double fractions[] = {0.25, 1.125};
+  out << BeginSeq;
+  EmitSeq(out, values);
+  out << Flow;
+  EmitSeq(out, values + 1, 2);
+  out << Flow << DoublePrecision(2);
+  EmitSeq(out, fractions);
+  out << EndSeq;
+
+  ExpectEmit("-\n  - 1\n  - -2\n  - 3\n- [-2, 3]\n- [0.25, 1.1]");
+}
+
+TEST_F(EmitterTest, NonNumberSeqs) {
+  std::vector<std::string> strings;
+  strings.push_back("a");
+  strings.push_back("b c");
+  std::vector<bool> bools(2, true);
+  out << Flow << BeginSeq << strings << bools << EndSeq;
+
+  ExpectEmit("[[a, b c], [true, true]]");
+}
+
 TEST_F(EmitterTest, SimpleComment) {
   out << BeginMap;
   out << Key << "method";
@@ -624,6 +713,23 @@ TEST_F(EmitterTest, ComplexGlobalSettings) {
   ExpectEmit("- key 1: value 1\n  key 2: [a, b, c]\n- [1, 2]:\n    a: b");
 }
 
+TEST_F(EmitterTest, LocalSettingsLastUntilTheirNodeEnds) {
+  out << BeginSeq;
+  for (int i = 0; i < 3; i++) {
+    out << Flow << BeginSeq << DoubleQuoted << "a"
+        << "b" << EndSeq;
+    out << "c";
+  }
+  out << DoubleQuoted << BeginSeq << "x"
+      << "y" << EndSeq;
+  out << "z";
+  out << EndSeq;
+
+  ExpectEmit(
+      "- [\"a\", b]\n- c\n- [\"a\", b]\n- c\n- [\"a\", b]\n- c\n"
+      "-\n  - \"x\"\n  - \"y\"\n- z");
+}
+
 TEST_F(EmitterTest, Null) {
   out << BeginSeq;
   out << Null;
@@ -652,6 +758,76 @@ TEST_F(EmitterTest, DoubleQuotedUnicode) {
   ExpectEmit("\"\x24 \xC2\xA2 \xE2\x82\xAC \xF0\xA4\xAD\xA2\"");
 }
 
+// the quoted string writers copy the bytes between escapes as they are, so
+// these check the edges of those runs
+TEST_F(EmitterTest, QuotedRunsEndingOnEscapes) {
+  out << Flow << BeginSeq;
+  out << DoubleQuoted << "a\"";
+  out << DoubleQuoted << "\\b";
+  out << DoubleQuoted << "a\tb\n";
+  out << DoubleQuoted << "\"\"";
+  out << SingleQuoted << "it's'";
+  out << EndSeq;
+
+  ExpectEmit(
+      "[\"a\\\"\", \"\\\\b\", \"a\\tb\\n\", \"\\\"\\\"\", 'it''s''']");
+}
+
+TEST_F(EmitterTest, DoubleQuotedControlCharacters) {
+  out << Flow << BeginSeq;
+  // 0x7F isn't escaped, and WriteCodePoint writes it in two bytes
+  out << DoubleQuoted << "a\x7F" "b";
+  out << DoubleQuoted << "\xC2\x80" "\xC2\x9F" "\xC2\xA0" "\xC2\xA1";
+  out << DoubleQuoted << "\x01" "x\x1F";
+  out << EndSeq;
+
+  ExpectEmit(
+      "[\"a\xC1\xBF" "b\", \"\\x80\\x9f\\xa0\xC2\xA1\", \"\\x01x\\x1f\"]");
+}
+
+TEST_F(EmitterTest, QuotedInvalidUtf8) {
+  out << Flow << BeginSeq;
+  out << DoubleQuoted << "a\xFF" "b";
+  out << DoubleQuoted << "a\xE2\x82";
+  out << DoubleQuoted << "\xE2\x82" "x";
+  out << DoubleQuoted << "\x80";
+  out << DoubleQuoted << "a\xC0\xAF" "b";
+  out << SingleQuoted << "a\xFF" "b";
+  out << SingleQuoted << "it's\xE2\x82";
+  out << EndSeq;
+
+  ExpectEmit(
+      "[\"a\xEF\xBF\xBD" "b\", \"a\xEF\xBF\xBD\", \"\xEF\xBF\xBD" "x\", "
+      "\"\xEF\xBF\xBD\", \"a/b\", 'a\xEF\xBF\xBD" "b', "
+      "'it''s\xEF\xBF\xBD']");
+}
+
+TEST_F(EmitterTest, QuotedByteOrderMarkAndSeparators) {
+  out << Flow << BeginSeq;
+  out << DoubleQuoted << "\xEF\xBB\xBF" "a";
+  out << DoubleQuoted << "a\xE2\x80\xA8" "b\xE2\x80\xA9";
+  out << SingleQuoted << "\xEF\xBB\xBF" "a";
+  out << EndSeq;
+
+  ExpectEmit(
+      "[\"\\ufeffa\", \"a\xE2\x80\xA8" "b\xE2\x80\xA9\", "
+      "'\xEF\xBB\xBF" "a']");
+}
+
+TEST_F(EmitterTest, EscapedNonAsciiInQuotes) {
+  out.SetOutputCharset(EscapeNonAscii);
+  out << Flow << BeginSeq;
+  out << "a\x7F" "b";
+  out << DoubleQuoted << "\xE2\x80\xA8" "a";
+  out << "\xFF";
+  out << SingleQuoted << "caf\xC3\xA9";
+  out << "a\xC0\xAF" "b";
+  out << EndSeq;
+
+  ExpectEmit(
+      "[\"a\\x7fb\", \"\\u2028a\", \"\\ufffd\", \"caf\\xe9\", \"a/b\"]");
+}
+
 struct Foo {
   Foo() : x(0) {}
   Foo(int x_, const std::string& bar_) : x(x_), bar(bar_) {}
@@ -800,6 +976,65 @@ TEST_F(EmitterTest, EmptyBinary) {
   ExpectEmit("!!binary \"\"");
 }
 
+// produces 'size' bytes of a pattern, a few at a time
+struct ByteProducer {
+  explicit ByteProducer(std::size_t size_) : size(size_), produced(0) {}
+
+  static std::size_t Produce(void* context, unsigned char* buffer,
+                             std::size_t capacity) {
+    ByteProducer& producer = *static_cast<ByteProducer*>(context);
+    std::size_t n = std::min(std::min<std::size_t>(capacity, 100),
+                             producer.size - producer.produced);
+    for (std::size_t i = 0; i < n; i++)
+      buffer[i] = static_cast<unsigned char>(producer.produced++ * 7);
+    return n;
+  }
+
+  std::size_t size;
+  std::size_t produced;
+};
+
+TEST_F(EmitterTest, BinaryStream) {
+  ByteProducer producer(120);
+  out << BeginMap;
+  out << Key << "data" << Value
+      << BinaryStream(ByteProducer::Produce, &producer);
+  out << Key << "next" << Value << 1;
+  out << EndMap;
+
+  ExpectEmit(
+      "data: !!binary |\n"
+      "  AAcOFRwjKjE4P0ZNVFtiaXB3foWMk5qhqK+2vcTL0tng5+71/AMKERgfJi00O0JJ"
+      "UFdeZWxzeoGI\n"
+      "  j5adpKuyucDHztXc4+rx+P8GDRQbIikwNz5FTFNaYWhvdn2Ei5KZoKeutbzDytHY"
+      "3+bt9PsCCRAX\n"
+      "  HiUsMzpB\n"
+      "next: 1");
+
+  std::vector<unsigned char> bytes(120);
+  for (std::size_t i = 0; i < bytes.size(); i++)
+    bytes[i] = static_cast<unsigned char>(i * 7);
+  Node doc;
+  std::stringstream stream(out.c_str());
+  Parser(stream).GetNextDocument(doc);
+  EXPECT_EQ(Binary(&bytes[0], bytes.size()), doc["data"].to<Binary>());
+}
+
+TEST_F(EmitterTest, BinaryStreamInFlow) {
+  ByteProducer producer(13);
+  out << Flow << BeginSeq << BinaryStream(ByteProducer::Produce, &producer)
+      << EndSeq;
+
+  ExpectEmit("[!!binary \"AAcOFRwjKjE4P0ZNVA==\"]");
+}
+
+TEST_F(EmitterTest, EmptyBinaryStream) {
+  ByteProducer producer(0);
+  out << BinaryStream(ByteProducer::Produce, &producer);
+
+  ExpectEmit("!!binary \"\"");
+}
+
 TEST_F(EmitterTest, ColonAtEndOfScalar) {
   out << "a:";
   ExpectEmit("\"a:\"");
@@ -916,6 +1151,42 @@ TEST_F(EmitterTest, DashInBlockContext) {
   ExpectEmit("key: \"-\"");
 }
 
+TEST_F(EmitterTest, PlainScalarChoices) {
+  const char* const plain[] = {"a:b", "a#b",  "-a",          "?a",
+                               "a\rb", "x-y", "a,b", "a[b]", "caf\xC3\xA9",
+                               "~x",  "a\xC2\x85"};
+  const char* const quoted[] = {"a: b", "a:",     "a #b",   "- a",  "? a",
+                                ": a",  "a ",     " a",     "#a",   "a\tb",
+                                "a\r\nb", "a\nb", "a\x01", "a\x7F", "null",
+                                "\xEF\xBB\xBFx", "a\xC2\x80"};
+
+  for (std::size_t i = 0; i < sizeof(plain) / sizeof(plain[0]); i++) {
+    Emitter emitter;
+    emitter << plain[i];
+    EXPECT_EQ(std::string(plain[i]), emitter.c_str());
+  }
+  for (std::size_t i = 0; i < sizeof(quoted) / sizeof(quoted[0]); i++) {
+    Emitter emitter;
+    emitter << quoted[i];
+    EXPECT_EQ('"', emitter.c_str()[0]) << emitter.c_str();
+  }
+
+  const char* const plainInFlow[] = {"a:b", "-a", "a#b", "a- b"};
+  const char* const quotedInFlow[] = {"a,b", "a]", "?a", "a{", "a:", "- a"};
+  for (std::size_t i = 0; i < sizeof(plainInFlow) / sizeof(plainInFlow[0]);
+       i++) {
+    Emitter emitter;
+    emitter << Flow << BeginSeq << plainInFlow[i] << EndSeq;
+    EXPECT_EQ("[" + std::string(plainInFlow[i]) + "]", emitter.c_str());
+  }
+  for (std::size_t i = 0; i < sizeof(quotedInFlow) / sizeof(quotedInFlow[0]);
+       i++) {
+    Emitter emitter;
+    emitter << Flow << BeginSeq << quotedInFlow[i] << EndSeq;
+    EXPECT_EQ('"', emitter.c_str()[1]) << emitter.c_str();
+  }
+}
+
 TEST_F(EmitterTest, HexAndOct) {
   out << Flow << BeginSeq;
   out << 31;
@@ -925,6 +1196,147 @@ TEST_F(EmitterTest, HexAndOct) {
   ExpectEmit("[31, 0x1f, 037]");
 }
 
+// what the emitter wrote numbers with before formatting them itself
+template <typename T>
+std::string StreamFormat(T value, EMITTER_MANIP intFormat) {
+  std::stringstream stream;
+  if (intFormat == Hex)
+    stream << "0x" << std::hex;
+  else if (intFormat == Oct)
+    stream << "0" << std::oct;
+  stream << value;
+  return stream.str();
+}
+
+template <typename T>
+void ExpectIntegersMatchStream() {
+  const T values[] = {0,
+                      1,
+                      static_cast<T>(-1),
+                      42,
+                      static_cast<T>(-42),
+                      std::numeric_limits<T>::min(),
+                      std::numeric_limits<T>::max()};
+  const EMITTER_MANIP formats[] = {Dec, Hex, Oct};
+  for (std::size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    for (std::size_t j = 0; j < 3; j++) {
+      Emitter emitter;
+      emitter << formats[j] << values[i];
+      EXPECT_EQ(StreamFormat(values[i], formats[j]), emitter.c_str());
+    }
+  }
+}
+
+template <typename T>
+void ExpectFloatsMatchStream(std::size_t precision) {
+  const T values[] = {0,
+                      -0.0,
+                      1,
+                      static_cast<T>(0.1),
+                      static_cast<T>(-1.5e-7),
+                      static_cast<T>(123456789.0),
+                      static_cast<T>(3.14159265358979),
+                      std::numeric_limits<T>::min(),
+                      std::numeric_limits<T>::max(),
+                      std::numeric_limits<T>::infinity(),
+                      -std::numeric_limits<T>::infinity()};
+  for (std::size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    std::stringstream stream;
+    stream.precision(precision);
+    stream << values[i];
+
+    Emitter emitter;
+    EXPECT_TRUE(emitter.SetFloatPrecision(std::min<std::size_t>(precision, 7)));
+    EXPECT_TRUE(emitter.SetDoublePrecision(precision));
+    emitter << values[i];
+    EXPECT_EQ(stream.str(), emitter.c_str());
+  }
+}
+
+TEST_F(EmitterTest, NumbersMatchStreamOutput) {
+  ExpectIntegersMatchStream<short>();
+  ExpectIntegersMatchStream<unsigned short>();
+  ExpectIntegersMatchStream<int>();
+  ExpectIntegersMatchStream<unsigned>();
+  ExpectIntegersMatchStream<long>();
+  ExpectIntegersMatchStream<unsigned long>();
+  ExpectIntegersMatchStream<long long>();
+  ExpectIntegersMatchStream<unsigned long long>();
+
+  const std::size_t precisions[] = {0, 1, 3, 7};
+  for (std::size_t i = 0; i < sizeof(precisions) / sizeof(precisions[0]);
+       i++) {
+    ExpectFloatsMatchStream<float>(precisions[i]);
+    ExpectFloatsMatchStream<double>(precisions[i]);
+  }
+  ExpectFloatsMatchStream<double>(16);
+}
+
+TEST_F(EmitterTest, StreamFlush) {
+  std::stringstream stream;
+  {
+    Emitter emitter(stream);
+    emitter << BeginMap << Key << "key" << Value << "value" << EndMap;
+    EXPECT_EQ("", stream.str());
+    EXPECT_EQ(10, emitter.size());
+    emitter.Flush();
+    EXPECT_EQ("key: value", stream.str());
+
+    emitter << Newline;
+  }
+  EXPECT_EQ("key: value\n", stream.str());
+
+  std::stringstream unbuffered;
+  Emitter emitter(unbuffered, 0);
+  emitter << Flow << BeginSeq << 1 << 2 << EndSeq;
+  EXPECT_EQ("[1, 2]", unbuffered.str());
+}
+
+TEST_F(EmitterTest, Reset) {
+  Emitter emitter(1024);
+  emitter.SetIndent(4);
+  emitter.SetSeqFormat(Flow);
+  emitter << BeginMap << Key << "a" << Value << BeginSeq << DoubleQuoted
+          << BeginSeq << "x";
+  emitter << EndMap;
+  EXPECT_FALSE(emitter.good());
+
+  for (int i = 0; i < 2; i++) {
+    emitter.Reset();
+    EXPECT_TRUE(emitter.good());
+    EXPECT_EQ(0, emitter.size());
+    EXPECT_EQ("", std::string(emitter.c_str()));
+
+    emitter << BeginMap << Key << "a" << Value << BeginSeq << "x"
+            << "y" << EndSeq << EndMap;
+    EXPECT_EQ("a:\n  - x\n  - y", std::string(emitter.c_str()));
+  }
+
+  std::stringstream stream;
+  Emitter streamEmitter(stream);
+  streamEmitter << BeginSeq << 1;
+  streamEmitter.Reset();
+  EXPECT_EQ("- 1", stream.str());
+  streamEmitter << "doc";
+  streamEmitter.Flush();
+  EXPECT_EQ("- 1doc", stream.str());
+}
+
+TEST_F(EmitterTest, TakeOutput) {
+  Emitter emitter;
+  emitter.Reserve(256);
+  emitter << BeginSeq << "a"
+          << "b" << EndSeq;
+
+  std::string output;
+  emitter.TakeOutput(output);
+  EXPECT_EQ("- a\n- b", output);
+  EXPECT_EQ(0, emitter.size());
+
+  emitter << Flow << BeginSeq << "c" << EndSeq;
+  EXPECT_EQ("[c]", std::string(emitter.c_str()));
+}
+
 TEST_F(EmitterTest, CompactMapWithNewline) {
   out << Comment("Characteristics");
   out << BeginSeq;
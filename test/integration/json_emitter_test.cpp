@@ -0,0 +1,133 @@
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "yaml-cpp/yaml.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+TEST(JsonEmitterTest, Scalars) {
+  YAML::JsonEmitter out;
+  out << YAML::BeginSeq << "a" << 1 << -2 << 3u << 1.5 << true << false
+      << YAML::Null << 'c' << YAML::EndSeq;
+  EXPECT_TRUE(out.good());
+  EXPECT_EQ("[\"a\",1,-2,3,1.5,true,false,null,\"c\"]",
+            std::string(out.c_str()));
+}
+
+TEST(JsonEmitterTest, Nested) {
+  YAML::JsonEmitter out;
+  out << YAML::BeginMap;
+  out << YAML::Key << "name" << YAML::Value << "x";
+  out << YAML::Key << "tags" << YAML::Value << YAML::Flow << YAML::BeginSeq
+      << "a" << YAML::BeginSeq << YAML::EndSeq << YAML::EndSeq;
+  out << "empty" << YAML::BeginMap << YAML::EndMap;
+  out << YAML::EndMap;
+  EXPECT_TRUE(out.good());
+  EXPECT_EQ("{\"name\":\"x\",\"tags\":[\"a\",[]],\"empty\":{}}",
+            std::string(out.c_str()));
+}
+
+TEST(JsonEmitterTest, Escapes) {
+  YAML::JsonEmitter out;
+  out << std::string("quote\" backslash\\ \n\t\r\b\f \x01\x1f caf\xC3\xA9 "
+                     "a long run without anything to escape in it");
+  EXPECT_EQ(
+      "\"quote\\\" backslash\\\\ \\n\\t\\r\\b\\f \\u0001\\u001f "
+      "caf\xC3\xA9 a long run without anything to escape in it\"",
+      std::string(out.c_str()));
+}
+
+TEST(JsonEmitterTest, EscapesAtEveryOffset) {
+  // the escaper looks at eight bytes at a time
+  for (std::size_t size = 0; size < 24; size++) {
+    for (std::size_t i = 0; i < size; i++) {
+      for (int which = 0; which < 3; which++) {
+        std::string str(size, 'a');
+        const char special[] = {'"', '\\', '\x10'};
+        str[i] = special[which];
+        const char* const escaped[] = {"\\\"", "\\\\", "\\u0010"};
+
+        YAML::JsonEmitter out;
+        out << str;
+        EXPECT_EQ("\"" + std::string(i, 'a') + escaped[which] +
+                      std::string(size - i - 1, 'a') + "\"",
+                  std::string(out.c_str()));
+      }
+    }
+  }
+}
+
+TEST(JsonEmitterTest, KeysAreStrings) {
+  YAML::JsonEmitter out;
+  out << YAML::BeginMap << 1 << 2 << true << 1.5 << YAML::Null << "x"
+      << YAML::EndMap;
+  EXPECT_EQ("{\"1\":2,\"true\":1.5,\"null\":\"x\"}", std::string(out.c_str()));
+}
+
+TEST(JsonEmitterTest, NonFiniteFloats) {
+  YAML::JsonEmitter out;
+  out << YAML::BeginSeq << std::numeric_limits<double>::infinity()
+      << -std::numeric_limits<float>::infinity()
+      << std::numeric_limits<double>::quiet_NaN() << YAML::EndSeq;
+  EXPECT_EQ("[null,null,null]", std::string(out.c_str()));
+}
+
+TEST(JsonEmitterTest, Containers) {
+  std::map<std::string, std::vector<int> > m;
+  m["a"].push_back(1);
+  m["a"].push_back(2);
+  m["b"];
+
+  YAML::JsonEmitter out;
+  out << m;
+  EXPECT_EQ("{\"a\":[1,2],\"b\":[]}", std::string(out.c_str()));
+}
+
+TEST(JsonEmitterTest, TopLevelValuesOnLines) {
+  std::stringstream stream;
+  {
+    YAML::JsonEmitter out(stream);
+    out << YAML::BeginMap << "a" << 1 << YAML::EndMap;
+    out << YAML::BeginMap << "a" << 2 << YAML::EndMap;
+  }
+  EXPECT_EQ("{\"a\":1}\n{\"a\":2}", stream.str());
+}
+
+TEST(JsonEmitterTest, Errors) {
+  YAML::JsonEmitter unmatched;
+  unmatched << YAML::BeginSeq << YAML::EndMap;
+  EXPECT_FALSE(unmatched.good());
+  EXPECT_EQ(YAML::ErrorMsg::UNEXPECTED_END_MAP, unmatched.GetLastError());
+
+  YAML::JsonEmitter collectionKey;
+  collectionKey << YAML::BeginMap << YAML::BeginSeq;
+  EXPECT_FALSE(collectionKey.good());
+  EXPECT_EQ(YAML::ErrorMsg::JSON_COLLECTION_KEY, collectionKey.GetLastError());
+
+  YAML::JsonEmitter missingValue;
+  missingValue << YAML::BeginMap << "a" << YAML::EndMap;
+  EXPECT_FALSE(missingValue.good());
+  EXPECT_EQ(YAML::ErrorMsg::JSON_MISSING_VALUE, missingValue.GetLastError());
+}
+
+TEST(JsonEmitterTest, ParsesBack) {
+  YAML::JsonEmitter out;
+  out << YAML::BeginMap << "text" << "line\nbreak \"quoted\"" << "n"
+      << 42 << YAML::EndMap;
+
+  std::stringstream stream(out.c_str());
+  YAML::Parser parser(stream);
+  YAML::Node doc;
+  ASSERT_TRUE(parser.GetNextDocument(doc));
+  std::string text;
+  int n = 0;
+  doc["text"] >> text;
+  doc["n"] >> n;
+  EXPECT_EQ("line\nbreak \"quoted\"", text);
+  EXPECT_EQ(42, n);
+}
+}
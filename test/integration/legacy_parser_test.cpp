@@ -1,7 +1,12 @@
 #include <algorithm>
+#include <limits>
+#include <map>
 #include <memory>
 #include <sstream>
+#include <vector>
 
+#include "yaml-cpp/aliasmanager.h"
+#include "yaml-cpp/emitfromevents.h"
 #include "yaml-cpp/yaml.h"
 
 #include "gtest/gtest.h"
@@ -201,6 +206,334 @@ TEST_F(LegacyParserTest, AliasAsSimpleKey) {
   EXPECT_EQ("c", doc[1]["b"].to<std::string>());
 }
 
+TEST_F(LegacyParserTest, EmitAliases) {
+  std::string input = "- &a x\n- &b y\n- *b\n- *a\n- &c z";
+  Parse(input);
+
+  EXPECT_FALSE(doc[4].IsAliased());
+  Emitter out;
+  out << doc;
+  EXPECT_STREQ("- &1 x\n- &2 y\n- *2\n- *1\n- z", out.c_str());
+}
+
+TEST_F(LegacyParserTest, Clone) {
+  std::string input = "{a: [1, 2], b: !foo c}";
+  Parse(input);
+
+  std::auto_ptr<Node> pClone = doc.Clone();
+  EXPECT_EQ(0, doc.Compare(*pClone));
+  EXPECT_EQ("!foo", (*pClone)["b"].Tag());
+  EXPECT_EQ(2, (*pClone)["a"][1].to<int>());
+}
+
+TEST_F(LegacyParserTest, CloneKeepsAliases) {
+  std::string input = "- &a [x, y]\n- *a";
+  Parse(input);
+
+  std::auto_ptr<Node> pClone = doc.Clone();
+  ASSERT_EQ(2, pClone->size());
+  EXPECT_EQ(&(*pClone)[0], &(*pClone)[1]);
+  EXPECT_TRUE((*pClone)[0].IsAliased());
+
+  Emitter original, copy;
+  original << doc;
+  copy << *pClone;
+  EXPECT_STREQ(original.c_str(), copy.c_str());
+}
+
+TEST_F(LegacyParserTest, AliasManagerAcrossDocuments) {
+  // the clone's nodes were parsed with the same anchors as the original's
+  Parse("- &a [x, y]\n- *a");
+  std::auto_ptr<Node> pClone = doc.Clone();
+
+  Emitter out;
+  EmitFromEvents handler(out);
+  AliasManager am;
+  out << BeginSeq;
+  doc.EmitEvents(am, handler);
+  pClone->EmitEvents(am, handler);
+  doc.EmitEvents(am, handler);
+  out << EndSeq;
+  EXPECT_STREQ(
+      "-\n  - &1 [x, y]\n  - *1\n-\n  - &2 [x, y]\n  - *2\n-\n  - *1\n"
+      "  - *1",
+      out.c_str());
+}
+
+TEST_F(LegacyParserTest, CloneSubtree) {
+  std::string input = "{a: {b: c}}";
+  Parse(input);
+
+  std::auto_ptr<Node> pClone = doc["a"].Clone();
+  EXPECT_EQ("c", (*pClone)["b"].to<std::string>());
+}
+
+TEST_F(LegacyParserTest, StringPool) {
+  std::stringstream stream(
+      "- {host: example.com, enabled: true}\n"
+      "- {host: example.com, enabled: true}\n"
+      "- !!str example.com");
+  Parser parser(stream);
+  StringPool pool;
+  Node pooled;
+  parser.GetNextDocument(pooled, pool);
+
+  ASSERT_EQ(3, pooled.size());
+  EXPECT_EQ("example.com", pooled[0]["host"].to<std::string>());
+  EXPECT_TRUE(pooled[1]["enabled"].to<bool>());
+  EXPECT_EQ("tag:yaml.org,2002:str", pooled[2].Tag());
+  EXPECT_EQ(&pooled[0].Tag(), &pooled[1].Tag());
+  EXPECT_EQ(&pooled[0]["host"].Scalar(), &pooled[1]["host"].Scalar());
+
+  // "?", "example.com", "host", "enabled", "true" and the !!str tag
+  EXPECT_EQ(6, pool.size());
+  EXPECT_EQ(pool.lookups() - pool.size(), pool.hits());
+
+  std::auto_ptr<Node> pClone = pooled.Clone();
+  EXPECT_EQ(0, pooled.Compare(*pClone));
+}
+
+void ExpectConversions(const Node& doc) {
+  EXPECT_EQ(42, doc[0].to<int>());
+  EXPECT_EQ(42, doc[0].to<int>());
+  EXPECT_EQ(42.0, doc[0].to<double>());
+  EXPECT_EQ(31, doc[1].to<short>());
+  EXPECT_EQ(31u, doc[1].to<unsigned>());
+
+  int i = 0;
+  EXPECT_FALSE(doc[2].Read(i));
+  EXPECT_EQ(0, i);
+  EXPECT_EQ(99999999999LL, doc[2].to<long long>());
+
+  EXPECT_FALSE(doc[3].Read(i));
+  EXPECT_EQ(1.5, doc[3].to<double>());
+  EXPECT_EQ(1.5f, doc[3].to<float>());
+  EXPECT_EQ(std::numeric_limits<double>::infinity(), doc[4].to<double>());
+
+  EXPECT_TRUE(doc[5].to<bool>());
+  EXPECT_FALSE(doc[6].to<bool>());
+  EXPECT_FALSE(doc[5].Read(i));
+
+  EXPECT_TRUE(IsNull(doc[7]));
+  EXPECT_TRUE(IsNull(doc[8]));
+  EXPECT_FALSE(IsNull(doc[10]));
+
+  EXPECT_FALSE(doc[9].Read(i));
+  EXPECT_EQ("str", doc[10].to<std::string>());
+}
+
+const char* const conversionsInput =
+    "[42, 0x1F, 99999999999, 1.5, .inf, true, off, ~, '', 12abc, str]";
+
+TEST_F(LegacyParserTest, Conversions) {
+  Parse(conversionsInput);
+  ExpectConversions(doc);
+}
+
+TEST_F(LegacyParserTest, CachedConversions) {
+  Parse(conversionsInput);
+  doc.CacheConversions();
+  ExpectConversions(doc);
+
+  std::auto_ptr<Node> pClone = doc.Clone();
+  ExpectConversions(*pClone);
+}
+
+TEST_F(LegacyParserTest, ScalarViews) {
+  std::string input = "{name: yaml-cpp, ~: nothing, list: [1, 2]}";
+  Parse(input);
+
+  const Node& name = doc["name"];
+  EXPECT_EQ("yaml-cpp", name.Scalar());
+  EXPECT_EQ(&name.Scalar(), &name.Scalar());
+
+  const char* data = 0;
+  std::size_t size = 0;
+  ASSERT_TRUE(name.GetScalar(data, size));
+  EXPECT_EQ("yaml-cpp", std::string(data, size));
+  EXPECT_FALSE(doc["list"].GetScalar(data, size));
+  EXPECT_THROW(doc["list"].Scalar(), InvalidScalar);
+
+  EXPECT_EQ("nothing", doc["~"].Scalar());
+  EXPECT_EQ("2", doc["list"][1].Scalar());
+  EXPECT_THROW(doc["missing"], TypedKeyNotFound<std::string>);
+
+  const char scalars[] = "0x10 yes ~ 2.5 .inf";
+  int i = 0;
+  EXPECT_TRUE(Convert(scalars, 4, i));
+  EXPECT_EQ(16, i);
+  EXPECT_FALSE(Convert(scalars, 6, i));
+  bool b = false;
+  EXPECT_TRUE(Convert(scalars + 5, 3, b));
+  EXPECT_TRUE(b);
+  _Null null;
+  EXPECT_TRUE(Convert(scalars + 9, 1, null));
+  double d = 0;
+  EXPECT_TRUE(Convert(scalars + 11, 3, d));
+  EXPECT_EQ(2.5, d);
+  EXPECT_TRUE(Convert(scalars + 15, 4, d));
+  EXPECT_EQ(std::numeric_limits<double>::infinity(), d);
+}
+
+TEST_F(LegacyParserTest, ReadSequence) {
+  Parse("[1, 0x10, -3, &a 4, *a, ~]");
+
+  std::vector<int> values;
+  EXPECT_FALSE(doc.ReadSequence(values));
+  ASSERT_EQ(5, values.size());
+  EXPECT_EQ(16, values[1]);
+  EXPECT_EQ(4, values[4]);
+
+  std::vector<std::string> strings;
+  EXPECT_TRUE(doc.ReadSequence(strings));
+  ASSERT_EQ(6, strings.size());
+  EXPECT_EQ("0x10", strings[1]);
+  EXPECT_EQ("~", strings[5]);
+
+  EXPECT_FALSE(doc[0].ReadSequence(values));
+  EXPECT_TRUE(values.empty());
+}
+
+TEST_F(LegacyParserTest, SequenceReader) {
+  std::stringstream stream(
+      "[1.5, 2, &a -3e2, *a]\n"
+      "--- [1, [2], 3]\n"
+      "--- [1, {a: b}]\n"
+      "--- {a: b}\n"
+      "--- [1, 2, oops, 4]");
+  Parser parser(stream);
+
+  std::vector<double> values;
+  SequenceReader<double> reader(values);
+  parser.HandleNextDocument(reader);
+  EXPECT_FALSE(reader.failed());
+  ASSERT_EQ(4, values.size());
+  EXPECT_EQ(1.5, values[0]);
+  EXPECT_EQ(-300, values[3]);
+
+  parser.HandleNextDocument(reader);
+  EXPECT_TRUE(reader.failed());
+  EXPECT_EQ(1, values.size());
+
+  parser.HandleNextDocument(reader);
+  EXPECT_TRUE(reader.failed());
+  EXPECT_EQ(1, values.size());
+
+  parser.HandleNextDocument(reader);
+  EXPECT_TRUE(reader.failed());
+  EXPECT_EQ(0, values.size());
+
+  parser.HandleNextDocument(reader);
+  EXPECT_TRUE(reader.failed());
+  EXPECT_EQ(2, values.size());
+  EXPECT_EQ(4, reader.failedMark().line);
+  EXPECT_EQ(11, reader.failedMark().column);
+}
+
+TEST_F(LegacyParserTest, ScalarHints) {
+  Parse(
+      "- ~\n- true\n- 12\n- 1.5\n- abc\n- '12'\n- |\n  12\n- [x]\n"
+      "- null");
+
+  EXPECT_EQ(ScalarHint::Null, doc[0].Hint());
+  EXPECT_EQ(ScalarHint::Bool, doc[1].Hint());
+  EXPECT_EQ(ScalarHint::Int, doc[2].Hint());
+  EXPECT_EQ(ScalarHint::Float, doc[3].Hint());
+  EXPECT_EQ(ScalarHint::String, doc[4].Hint());
+  EXPECT_EQ(ScalarHint::Quoted, doc[5].Hint());
+  EXPECT_EQ(ScalarHint::Quoted, doc[6].Hint());
+  EXPECT_EQ(ScalarHint::Unknown, doc[7].Hint());
+  EXPECT_EQ(ScalarHint::Null, doc[8].Hint());
+
+  // quoted scalars still convert
+  EXPECT_EQ(12, doc[5].to<int>());
+  EXPECT_EQ(12u, doc[6].to<unsigned>());
+  EXPECT_EQ(12u, doc[2].to<unsigned>());
+  EXPECT_EQ(1.5f, doc[3].to<float>());
+  unsigned u = 0;
+  EXPECT_FALSE(doc[3].Read(u));
+  EXPECT_FALSE(doc[4].Read(u));
+  EXPECT_EQ('~', doc[0].to<char>());
+
+  std::auto_ptr<Node> pClone = doc.Clone();
+  EXPECT_EQ(ScalarHint::Int, (*pClone)[2].Hint());
+}
+
+TEST_F(LegacyParserTest, FoldedScalarHints) {
+  Parse("- 12\n  34\n- 1.5\n\n  \n- 7   # seven\n- {a: 0x1F, b: 1e3}");
+
+  EXPECT_EQ("12 34", doc[0].to<std::string>());
+  EXPECT_EQ(ScalarHint::String, doc[0].Hint());
+  EXPECT_EQ(ScalarHint::Float, doc[1].Hint());
+  EXPECT_EQ(ScalarHint::Int, doc[2].Hint());
+  EXPECT_EQ(ScalarHint::Int, doc[3]["a"].Hint());
+  EXPECT_EQ(ScalarHint::Float, doc[3]["b"].Hint());
+}
+
+struct Point {
+  int x, y;
+  bool operator==(const Point& rhs) const { return x == rhs.x && y == rhs.y; }
+};
+
+bool TryDecode(const Node& node, Point& point) {
+  return node.Type() == NodeType::Sequence && node.size() == 2 &&
+         node[0].Read(point.x) && node[1].Read(point.y);
+}
+
+// only has the throwing operator >>
+struct Cell {
+  int row, column;
+  bool operator==(const Cell& rhs) const {
+    return row == rhs.row && column == rhs.column;
+  }
+};
+
+void operator>>(const Node& node, Cell& cell) {
+  node[0] >> cell.row;
+  node[1] >> cell.column;
+}
+
+TEST_F(LegacyParserTest, TryDecode) {
+  Parse("{[1, 2]: a, [3, 4]: b, c: d, [5]: e}");
+
+  Point point = {3, 4};
+  const Node* pValue = doc.FindValue(point);
+  ASSERT_TRUE(pValue);
+  EXPECT_EQ("b", pValue->to<std::string>());
+  EXPECT_FALSE(doc["c"].Read(point));
+
+  Cell cell = {3, 4};
+  pValue = doc.FindValue(cell);
+  ASSERT_TRUE(pValue);
+  EXPECT_EQ("b", pValue->to<std::string>());
+  EXPECT_FALSE(doc["c"].Read(cell));
+}
+
+TEST_F(LegacyParserTest, TryDecodeContainers) {
+  Parse("{a: [1, 2, 3], b: {x: 1, y: 2}, c: [1, x], d: ~, e: []}");
+
+  std::vector<int> values;
+  EXPECT_TRUE(doc["a"].Read(values));
+  ASSERT_EQ(3, values.size());
+  EXPECT_EQ(3, values[2]);
+  EXPECT_FALSE(doc["c"].Read(values));
+  EXPECT_TRUE(doc["d"].Read(values));
+  EXPECT_TRUE(values.empty());
+
+  std::map<std::string, int> map;
+  EXPECT_TRUE(doc["b"].Read(map));
+  ASSERT_EQ(2, map.size());
+  EXPECT_EQ(2, map["y"]);
+  EXPECT_FALSE(doc["a"].Read(map));
+  EXPECT_FALSE(doc.Read(map));
+  map["z"] = 1;
+  EXPECT_TRUE(doc["e"].Read(map));
+  EXPECT_TRUE(map.empty());
+  map["z"] = 1;
+  EXPECT_TRUE(doc["d"].Read(map));
+  EXPECT_TRUE(map.empty());
+}
+
 TEST_F(LegacyParserTest, ExplicitDoc) {
   std::string input = "---\n- one\n- two";
   Parse(input);
@@ -460,6 +793,23 @@ TEST_F(LegacyParserTest, Binary) {
   EXPECT_EQ(binary1, doc[1].to<Binary>());
 }
 
+TEST_F(LegacyParserTest, DecodeBinary) {
+  Parse("- !!binary |\n  SGVsbG8s\n  IFdvcmxkIQ==\n- !!binary \"Zm9v!\"\n- [a]");
+
+  unsigned char buffer[13];
+  std::size_t size = 0;
+  EXPECT_TRUE(DecodeBinary(doc[0], buffer, sizeof(buffer), size));
+  EXPECT_EQ("Hello, World!",
+            std::string(reinterpret_cast<char*>(buffer), size));
+  EXPECT_FALSE(DecodeBinary(doc[0], buffer, 12, size));
+  EXPECT_FALSE(DecodeBinary(doc[1], buffer, sizeof(buffer), size));
+  EXPECT_FALSE(DecodeBinary(doc[2], buffer, sizeof(buffer), size));
+
+  Binary binary0(reinterpret_cast<const unsigned char*>("Hello, World!"), 13);
+  EXPECT_EQ(binary0, doc[0].to<Binary>());
+  EXPECT_EQ(Binary(), doc[1].to<Binary>());
+}
+
 TEST_F(LegacyParserTest, DereferenceScalar) {
   std::string input = "key";
   Parse(input);
@@ -0,0 +1,173 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "yaml-cpp/yaml.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+struct Endpoint {
+  Endpoint() : port(0) {}
+
+  std::string host;
+  int port;
+};
+
+struct Config {
+  Config() : enabled(false), ratio(0.0) {}
+
+  std::string name;
+  bool enabled;
+  double ratio;
+  Endpoint primary;
+  std::vector<Endpoint> replicas;
+  std::vector<int> ports;
+};
+
+struct Wide {
+  int a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p;
+};
+
+struct Flags {
+  std::vector<bool> bits;
+};
+}
+
+YAML_BEGIN_FIELDS(Endpoint)
+  YAML_FIELD(host)
+  YAML_FIELD(port)
+YAML_END_FIELDS()
+
+YAML_BEGIN_FIELDS(Flags)
+  YAML_FIELD(bits)
+YAML_END_FIELDS()
+
+// the same as YAML_BEGIN_FIELDS ... YAML_END_FIELDS
+namespace YAML {
+template <>
+struct struct_fields<Config> {
+  static void Describe(FieldList<Config>& fields) {
+    fields("name", &Config::name)("enabled", &Config::enabled)(
+        "ratio", &Config::ratio)("primary", &Config::primary)(
+        "replicas", &Config::replicas)("ports", &Config::ports);
+  }
+};
+}
+
+namespace YAML {
+namespace {
+template <typename T>
+bool Decode(const std::string& input, T& object, Mark* pMark = 0) {
+  std::stringstream stream(input);
+  Parser parser(stream);
+  StructDecoder<T> decoder(object);
+  parser.HandleNextDocument(decoder);
+  if (pMark)
+    *pMark = decoder.failedMark();
+  return !decoder.failed();
+}
+
+TEST(StructDecoderTest, Fields) {
+  Config config;
+  ASSERT_TRUE(Decode(
+      "name: main\n"
+      "enabled: yes\n"
+      "ratio: 0.25\n"
+      "primary: {host: a.example.com, port: 80}\n"
+      "replicas:\n"
+      "  - {host: b.example.com, port: 81}\n"
+      "  - host: c.example.com\n"
+      "ports: [1, 2, 3]\n",
+      config));
+
+  EXPECT_EQ("main", config.name);
+  EXPECT_TRUE(config.enabled);
+  EXPECT_EQ(0.25, config.ratio);
+  EXPECT_EQ("a.example.com", config.primary.host);
+  EXPECT_EQ(80, config.primary.port);
+  ASSERT_EQ(2, config.replicas.size());
+  EXPECT_EQ("b.example.com", config.replicas[0].host);
+  EXPECT_EQ(81, config.replicas[0].port);
+  EXPECT_EQ("c.example.com", config.replicas[1].host);
+  EXPECT_EQ(0, config.replicas[1].port);
+  ASSERT_EQ(3, config.ports.size());
+  EXPECT_EQ(3, config.ports[2]);
+}
+
+TEST(StructDecoderTest, SkipsUnknownKeys) {
+  Config config;
+  config.ratio = 1.5;
+  ASSERT_TRUE(Decode(
+      "extra: {a: [1, {b: c}], d: e}\n"
+      "[complex, key]: {f: g}\n"
+      "name: kept\n"
+      "primary: ~\n"
+      "other: [x, y]\n",
+      config));
+
+  EXPECT_EQ("kept", config.name);
+  EXPECT_EQ(1.5, config.ratio);
+  EXPECT_EQ("", config.primary.host);
+}
+
+TEST(StructDecoderTest, SkipsAliasedKeys) {
+  Endpoint endpoint;
+  ASSERT_TRUE(Decode("&k host: x\n*k : y\nport: 80\n", endpoint));
+
+  EXPECT_EQ("x", endpoint.host);
+  EXPECT_EQ(80, endpoint.port);
+}
+
+TEST(StructDecoderTest, Failures) {
+  Config config;
+  Mark mark;
+  EXPECT_FALSE(Decode("name: a\nport: 1\nenabled: maybe\n", config, &mark));
+  EXPECT_EQ(2, mark.line);
+  EXPECT_EQ(9, mark.column);
+  EXPECT_EQ("a", config.name);
+
+  EXPECT_FALSE(Decode("primary: [1, 2]", config));
+  EXPECT_FALSE(Decode("ports: [1, x]", config));
+  EXPECT_FALSE(Decode("ports: 1", config));
+  EXPECT_FALSE(Decode("[a, b]", config));
+  EXPECT_FALSE(Decode("name: &a x\nprimary: {host: *a}", config));
+}
+
+TEST(StructDecoderTest, BoolSequence) {
+  Flags flags;
+  ASSERT_TRUE(Decode("bits: [yes, false, on]", flags));
+  ASSERT_EQ(3, flags.bits.size());
+  EXPECT_TRUE(flags.bits[0]);
+  EXPECT_FALSE(flags.bits[1]);
+  EXPECT_TRUE(flags.bits[2]);
+
+  EXPECT_FALSE(Decode("bits: [true, 2]", flags));
+  EXPECT_FALSE(Decode("bits: [true, [false]]", flags));
+}
+
+TEST(StructDecoderTest, ManyFields) {
+  // enough fields that the perfect hash has to look for a seed
+  Wide wide = Wide();
+  StructTypeDecoder decoder;
+  const char* names[] = {"a", "b", "c", "d", "e", "f", "g", "h",
+                         "i", "j", "k", "l", "m", "n", "o", "p"};
+  int Wide::*members[] = {&Wide::a, &Wide::b, &Wide::c, &Wide::d,
+                          &Wide::e, &Wide::f, &Wide::g, &Wide::h,
+                          &Wide::i, &Wide::j, &Wide::k, &Wide::l,
+                          &Wide::m, &Wide::n, &Wide::o, &Wide::p};
+  FieldList<Wide> fields(decoder);
+  for (int i = 0; i < 16; i++)
+    fields(names[i], members[i]);
+  decoder.Finish();
+
+  for (int i = 0; i < 16; i++) {
+    const FieldDecoder* pField = decoder.FindField(names[i]);
+    ASSERT_TRUE(pField != 0);
+    EXPECT_EQ(&(wide.*members[i]), pField->Member(&wide));
+  }
+  EXPECT_TRUE(decoder.FindField("q") == 0);
+  EXPECT_TRUE(decoder.FindField("") == 0);
+}
+}
+}
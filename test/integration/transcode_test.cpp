@@ -0,0 +1,123 @@
+#include <sstream>
+#include <string>
+
+#include "yaml-cpp/yaml.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+std::string Transcode(const std::string& input,
+                      const YAML::TranscodeOptions& options =
+                          YAML::TranscodeOptions()) {
+  std::stringstream in(input), out;
+  YAML::Transcode(in, out, options);
+  return out.str();
+}
+
+TEST(TranscodeTest, KeepsStyles) {
+  EXPECT_EQ("a: 1\nb: [x, y]\nc:\n  - z\n",
+            Transcode("a: 1\nb: [x, y]\nc:\n- z\n"));
+}
+
+TEST(TranscodeTest, ForcesStyle) {
+  YAML::TranscodeOptions options;
+  options.style = YAML::EmitterStyle::Flow;
+  EXPECT_EQ("{a: 1, b: [x, y], c: [z]}\n",
+            Transcode("a: 1\nb: [x, y]\nc:\n- z\n", options));
+
+  options.style = YAML::EmitterStyle::Block;
+  options.indent = 4;
+  EXPECT_EQ("a:  1\nb:\n    -   x\n    -   y\n",
+            Transcode("{a: 1, b: [x, y]}", options));
+}
+
+TEST(TranscodeTest, StringFormat) {
+  YAML::TranscodeOptions options;
+  options.stringFormat = YAML::DoubleQuoted;
+  EXPECT_EQ("\"a\": \"b\"\n", Transcode("a: b", options));
+}
+
+TEST(TranscodeTest, StringFormatLeavesTypedScalarsPlain) {
+  YAML::TranscodeOptions options;
+  options.style = YAML::EmitterStyle::Flow;
+  options.stringFormat = YAML::DoubleQuoted;
+  EXPECT_EQ("{\"a\": 1, \"b\": ~, \"c\": true, \"d\": 1.5e3, \"e\": \"1\"}\n",
+            Transcode("a: 1\nb: ~\nc: true\nd: 1.5e3\ne: '1'\n", options));
+
+  options.stringFormat = YAML::SingleQuoted;
+  EXPECT_EQ("['x', 0x1F, ~, 'one two']\n",
+            Transcode("[x, 0x1F, null, one two]", options));
+}
+
+TEST(TranscodeTest, Json) {
+  YAML::TranscodeOptions options;
+  options.json = true;
+  EXPECT_EQ("{\"a\":1,\"b\":null,\"c\":true,\"d\":1500,\"e\":\"1\","
+            "\"f\":[\"x\",31,-0.5,null,false]}\n",
+            Transcode("a: 1\nb: ~\nc: true\nd: 1.5e3\ne: '1'\n"
+                      "f: [x, 0x1F, -.5, null, off]\n",
+                      options));
+
+  // tags are dropped, non-string keys are quoted, and documents are lines
+  EXPECT_EQ("{\"1\":\"a\",\"true\":\"b\"}\n[]\n",
+            Transcode("1: !foo a\ntrue: b\n---\n[]\n", options));
+
+  // too big for any integer, but still a number
+  EXPECT_EQ("[1e+20,\"not a number\"]\n",
+            Transcode("[100000000000000000000, not a number]", options));
+}
+
+TEST(TranscodeTest, JsonAliases) {
+  YAML::TranscodeOptions options;
+  options.json = true;
+  EXPECT_EQ("{\"a\":{\"x\":[1,2]},\"b\":{\"x\":[1,2]},\"c\":[1,2],"
+            "\"d\":3,\"e\":3}\n",
+            Transcode("a: &a {x: &b [1, 2]}\nb: *a\nc: *b\n"
+                      "d: &c 3\ne: *c\n",
+                      options));
+
+  // an anchor can be reused, and the later node wins
+  EXPECT_EQ("[\"x\",\"x\",\"z\",\"z\"]\n",
+            Transcode("[&a x, *a, &a z, *a]", options));
+}
+
+TEST(TranscodeTest, JsonToEmitter) {
+  std::stringstream in("- a\n- {b: 2}\n---\nc\n");
+  YAML::JsonEmitter emitter;
+  EXPECT_EQ(2, YAML::Transcode(in, emitter));
+  EXPECT_EQ("[\"a\",{\"b\":2}]\n\"c\"", std::string(emitter.c_str()));
+}
+
+TEST(TranscodeTest, PropertiesAndQuotes) {
+  EXPECT_EQ("- &1 a\n- *1\n- !<!foo> b\n- \"1\"\n",
+            Transcode("- &x a\n- *x\n- !foo b\n- '1'\n"));
+}
+
+TEST(TranscodeTest, Documents) {
+  std::stringstream in("a\n---\n- b\n---\nc: d\n"), out;
+  EXPECT_EQ(3, YAML::Transcode(in, out));
+  EXPECT_EQ("a\n---\n- b\n---\nc: d\n", out.str());
+
+  std::stringstream empty("# nothing\n"), emptyOut;
+  EXPECT_EQ(0, YAML::Transcode(empty, emptyOut));
+  EXPECT_EQ("", emptyOut.str());
+}
+
+TEST(TranscodeTest, ToEmitter) {
+  std::stringstream in("[1, [2, 3]]");
+  YAML::Emitter emitter;
+  EXPECT_EQ(1, YAML::Transcode(in, emitter));
+  EXPECT_EQ("[1, [2, 3]]", std::string(emitter.c_str()));
+}
+
+TEST(TranscodeTest, Errors) {
+  std::stringstream in("[a, b"), out;
+  EXPECT_THROW(YAML::Transcode(in, out), YAML::ParserException);
+
+  YAML::TranscodeOptions options;
+  options.indent = 1;
+  std::stringstream valid("a"), validOut;
+  EXPECT_THROW(YAML::Transcode(valid, validOut, options),
+               YAML::EmitterException);
+}
+}
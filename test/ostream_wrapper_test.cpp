@@ -1,5 +1,7 @@
 #include <stddef.h>
+#include <cstring>
 #include <sstream>
+#include <string>
 
 #include "gtest/gtest.h"
 #include "yaml-cpp/ostream_wrapper.h"
@@ -22,6 +24,36 @@ TEST(OstreamWrapperTest, BufferWriteCStr) {
   EXPECT_STREQ("Hello, world", wrapper.str());
 }
 
+TEST(OstreamWrapperTest, BufferGrows) {
+  YAML::ostream_wrapper wrapper;
+  std::string expected;
+  for (int i = 0; i < 1000; i++) {
+    const std::string piece(i % 7, 'a' + i % 26);
+    wrapper.write(piece);
+    expected += piece;
+  }
+  EXPECT_EQ(expected, wrapper.str());
+  EXPECT_EQ(expected.size(), wrapper.pos());
+}
+
+TEST(OstreamWrapperTest, BufferTake) {
+  YAML::ostream_wrapper wrapper;
+  wrapper.reserve(64);
+  wrapper.write("Hello,\nworld");
+  const char* const buffer = wrapper.str();
+
+  std::string output = "old output";
+  wrapper.take(output);
+  EXPECT_EQ("Hello,\nworld", output);
+  EXPECT_EQ(buffer, output.c_str());
+  EXPECT_STREQ("", wrapper.str());
+  EXPECT_EQ(0, wrapper.pos());
+  EXPECT_EQ(0, wrapper.row());
+
+  wrapper.write("again");
+  EXPECT_STREQ("again", wrapper.str());
+}
+
 TEST(OstreamWrapperTest, StreamNoWrite) {
   std::stringstream stream;
   YAML::ostream_wrapper wrapper(stream);
@@ -33,6 +65,7 @@ TEST(OstreamWrapperTest, StreamWriteStr) {
   std::stringstream stream;
   YAML::ostream_wrapper wrapper(stream);
   wrapper.write(std::string("Hello, world"));
+  wrapper.flush();
   EXPECT_STREQ(NULL, wrapper.str());
   EXPECT_EQ("Hello, world", stream.str());
 }
@@ -41,10 +74,44 @@ TEST(OstreamWrapperTest, StreamWriteCStr) {
   std::stringstream stream;
   YAML::ostream_wrapper wrapper(stream);
   wrapper.write("Hello, world");
+  wrapper.flush();
   EXPECT_STREQ(NULL, wrapper.str());
   EXPECT_EQ("Hello, world", stream.str());
 }
 
+TEST(OstreamWrapperTest, StreamWritesInBlocks) {
+  std::stringstream stream;
+  YAML::ostream_wrapper wrapper(stream, 8);
+  wrapper.write("Hello");
+  EXPECT_EQ("", stream.str());
+  wrapper.write(", ");
+  EXPECT_EQ("", stream.str());
+  wrapper.write("world");
+  EXPECT_EQ("Hello, ", stream.str());
+  wrapper.write("\nthis is longer than a block\n");
+  EXPECT_EQ("Hello, world\nthis is longer than a block\n", stream.str());
+  EXPECT_EQ(2, wrapper.row());
+  EXPECT_EQ(0, wrapper.col());
+  EXPECT_EQ(41, wrapper.pos());
+}
+
+TEST(OstreamWrapperTest, StreamFlushesOnDestruction) {
+  std::stringstream stream;
+  {
+    YAML::ostream_wrapper wrapper(stream);
+    wrapper.write("Hello, world");
+    EXPECT_EQ("", stream.str());
+  }
+  EXPECT_EQ("Hello, world", stream.str());
+}
+
+TEST(OstreamWrapperTest, StreamWithoutBlock) {
+  std::stringstream stream;
+  YAML::ostream_wrapper wrapper(stream, 0);
+  wrapper.write("Hello, world");
+  EXPECT_EQ("Hello, world", stream.str());
+}
+
 TEST(OstreamWrapperTest, Position) {
   YAML::ostream_wrapper wrapper;
   wrapper.write("Hello, world\n");
@@ -53,6 +120,40 @@ TEST(OstreamWrapperTest, Position) {
   EXPECT_EQ(13, wrapper.pos());
 }
 
+TEST(OstreamWrapperTest, PositionAcrossWrites) {
+  const char* const pieces[] = {"", "a", "\n", "bc\n", "\n\n", "def",
+                                "g\nhi", "\nj\nkl\n", "mnop", "\n"};
+  const std::size_t count = sizeof(pieces) / sizeof(pieces[0]);
+
+  // every pair of pieces, against counting one character at a time
+  for (std::size_t i = 0; i < count; i++) {
+    for (std::size_t j = 0; j < count; j++) {
+      YAML::ostream_wrapper wrapper;
+      wrapper.write(pieces[i]);
+      wrapper.set_comment();
+      wrapper.write(pieces[j]);
+
+      const std::string output = std::string(pieces[i]) + pieces[j];
+      std::size_t row = 0, col = 0;
+      bool comment = true;
+      for (std::size_t k = 0; k < output.size(); k++) {
+        col++;
+        if (output[k] == '\n') {
+          row++;
+          col = 0;
+          if (k >= std::strlen(pieces[i]))
+            comment = false;
+        }
+      }
+
+      EXPECT_EQ(output.size(), wrapper.pos()) << output;
+      EXPECT_EQ(row, wrapper.row()) << output;
+      EXPECT_EQ(col, wrapper.col()) << output;
+      EXPECT_EQ(comment, wrapper.comment()) << output;
+    }
+  }
+}
+
 TEST(OstreamWrapperTest, Comment) {
   YAML::ostream_wrapper wrapper;
   wrapper.write("Hello, world ");
@@ -0,0 +1,96 @@
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+#include "gtest/gtest.h"
+#include "yaml-cpp/emitter.h"
+#include "yaml-cpp/emittermanip.h"
+#include "yaml-cpp/ostream_wrapper.h"
+#include "yaml-cpp/outputsink.h"
+
+namespace {
+void AppendBlock(void* context, const char* data, std::size_t size) {
+  std::vector<std::string>& blocks =
+      *static_cast<std::vector<std::string>*>(context);
+  blocks.push_back(std::string(data, size));
+}
+
+TEST(OutputSinkTest, StreamSink) {
+  std::stringstream stream;
+  YAML::StreamSink sink(stream);
+  {
+    YAML::ostream_wrapper wrapper(sink);
+    wrapper.write("Hello, world");
+    EXPECT_STREQ(NULL, wrapper.str());
+  }
+  EXPECT_EQ("Hello, world", stream.str());
+}
+
+TEST(OutputSinkTest, FixedBuffer) {
+  char buffer[16];
+  YAML::FixedBufferSink sink(buffer, sizeof(buffer));
+  {
+    YAML::Emitter out(sink);
+    out << YAML::Flow << YAML::BeginSeq << 1 << 2 << 3 << YAML::EndSeq;
+  }
+  EXPECT_FALSE(sink.overflowed());
+  EXPECT_EQ("[1, 2, 3]", std::string(buffer, sink.size()));
+
+  YAML::FixedBufferSink small(buffer, 4);
+  {
+    YAML::Emitter out(small);
+    out << "Hello, world";
+  }
+  EXPECT_TRUE(small.overflowed());
+  EXPECT_EQ("Hell", std::string(buffer, small.size()));
+}
+
+TEST(OutputSinkTest, CallbackGetsBlocks) {
+  std::vector<std::string> blocks;
+  YAML::CallbackSink sink(AppendBlock, &blocks);
+  YAML::ostream_wrapper wrapper(sink, 4);
+  wrapper.write("abc");
+  wrapper.write("de");
+  EXPECT_EQ(1, blocks.size());
+  wrapper.write("fghij");  // doesn't fit, so it skips the block
+  wrapper.write("k");
+  EXPECT_EQ(3, blocks.size());
+  wrapper.flush();
+
+  ASSERT_EQ(4, blocks.size());
+  EXPECT_EQ("abc", blocks[0]);
+  EXPECT_EQ("de", blocks[1]);
+  EXPECT_EQ("fghij", blocks[2]);
+  EXPECT_EQ("k", blocks[3]);
+}
+
+#if !defined(_WIN32)
+TEST(OutputSinkTest, FileDescriptor) {
+  std::FILE* file = std::tmpfile();
+  ASSERT_TRUE(file);
+  {
+    YAML::FileDescriptorSink sink(fileno(file));
+    YAML::Emitter out(sink);
+    out << YAML::BeginMap << YAML::Key << "key" << YAML::Value << "value"
+        << YAML::EndMap;
+    out.Flush();
+    EXPECT_FALSE(sink.failed());
+  }
+
+  char buffer[32];
+  std::rewind(file);
+  const std::size_t size = std::fread(buffer, 1, sizeof(buffer), file);
+  std::fclose(file);
+  EXPECT_EQ("key: value", std::string(buffer, size));
+
+  YAML::FileDescriptorSink closed(-1);
+  closed.Write("x", 1);
+  EXPECT_TRUE(closed.failed());
+}
+#endif
+}
@@ -0,0 +1,788 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "yaml-cpp/yaml.h"  // IWYU pragma: keep
+
+// bench [name...]
+// . Times yaml-cpp's hot paths (each against the code it replaced, where
+//   that's still reproducible here); with no names, runs all of them.
+
+// the heap bytes currently allocated through operator new, so a benchmark
+// can measure what a structure keeps resident
+namespace {
+std::size_t liveHeapBytes;
+
+// a header before each block remembers its size (and keeps the alignment)
+const std::size_t allocationHeader = 16;
+}
+
+#if __cplusplus >= 201103L
+#define BENCH_THROWS_BAD_ALLOC
+#define BENCH_THROWS_NOTHING noexcept
+#else
+#define BENCH_THROWS_BAD_ALLOC throw(std::bad_alloc)
+#define BENCH_THROWS_NOTHING throw()
+#endif
+
+void* operator new(std::size_t size) BENCH_THROWS_BAD_ALLOC {
+  char* block = static_cast<char*>(std::malloc(size + allocationHeader));
+  if (!block)
+    throw std::bad_alloc();
+  *reinterpret_cast<std::size_t*>(block) = size;
+  liveHeapBytes += size;
+  return block + allocationHeader;
+}
+
+void operator delete(void* p) BENCH_THROWS_NOTHING {
+  if (!p)
+    return;
+  char* block = static_cast<char*>(p) - allocationHeader;
+  liveHeapBytes -= *reinterpret_cast<std::size_t*>(block);
+  std::free(block);
+}
+
+namespace {
+class Timer {
+ public:
+  Timer() : m_start(std::clock()) {}
+  double seconds() const {
+    return static_cast<double>(std::clock() - m_start) / CLOCKS_PER_SEC;
+  }
+
+ private:
+  std::clock_t m_start;
+};
+
+void Report(const char* label, std::size_t count, double seconds) {
+  std::printf("  %-32s %10.1f ns/op\n", label,
+              count ? 1e9 * seconds / count : 0.0);
+}
+
+// keeps the optimizer from discarding results
+volatile double sink;
+
+////////////////////////////////////////////////////////////////
+// numbers: Convert<T> on typical scalars
+
+const char* const integerScalars[] = {"0",    "42",   "-17",   "65535",
+                                      "0x1F", "017",  "100",   "2147483647",
+                                      "7",    "1024", "-9999", "31337"};
+const char* const floatScalars[] = {"0.5",    "3.14159",   "-2.75",   "1e10",
+                                    "100.0",  "-0.001",    "2.5e-3",  "0.1",
+                                    "42",     "1234.5678", "9.80665", "-1.0",
+                                    "6.02e23", "299792458"};
+
+template <typename T>
+bool StreamConvert(const std::string& input, T& output) {
+  std::stringstream stream(input);
+  stream.unsetf(std::ios::dec);
+  return (stream >> output) && (stream >> std::ws).eof();
+}
+
+template <typename T>
+void BenchConvert(const char* type, const char* const* scalars,
+                  std::size_t count) {
+  const std::size_t rounds = 200000;
+  std::vector<std::string> inputs(scalars, scalars + count);
+  std::string label;
+
+  Timer stream;
+  for (std::size_t r = 0; r < rounds; r++) {
+    for (std::size_t i = 0; i < count; i++) {
+      T value = T();
+      StreamConvert(inputs[i], value);
+      sink = sink + value;
+    }
+  }
+  label = std::string(type) + " (stringstream)";
+  Report(label.c_str(), rounds * count, stream.seconds());
+
+  Timer convert;
+  for (std::size_t r = 0; r < rounds; r++) {
+    for (std::size_t i = 0; i < count; i++) {
+      T value = T();
+      YAML::Convert(inputs[i], value);
+      sink = sink + value;
+    }
+  }
+  label = std::string(type) + " (Convert)";
+  Report(label.c_str(), rounds * count, convert.seconds());
+}
+
+void BenchNumbers() {
+  const std::size_t integers = sizeof(integerScalars) / sizeof(char*);
+  const std::size_t floats = sizeof(floatScalars) / sizeof(char*);
+  BenchConvert<int>("int", integerScalars, integers);
+  BenchConvert<long long>("long long", integerScalars, integers);
+  BenchConvert<float>("float", floatScalars, floats);
+  BenchConvert<double>("double", floatScalars, floats);
+}
+
+////////////////////////////////////////////////////////////////
+// sequence: reading a large numeric sequence into a std::vector
+
+std::string NumericSequence(std::size_t count) {
+  std::stringstream stream;
+  stream << "[";
+  for (std::size_t i = 0; i < count; i++)
+    stream << (i ? ", " : "") << (i * 7919) % 100003;
+  stream << "]";
+  return stream.str();
+}
+
+void BenchSequence() {
+  const std::size_t count = 200000;
+  const std::string input = NumericSequence(count);
+  std::vector<int> values;
+
+  std::stringstream stream(input);
+  YAML::Parser parser(stream);
+  YAML::Node doc;
+  Timer parse;
+  parser.GetNextDocument(doc);
+  Report("parse into Node", count, parse.seconds());
+
+  Timer extract;
+  doc >> values;
+  Report("operator>> (per element)", count, extract.seconds());
+
+  Timer read;
+  doc.ReadSequence(values);
+  Report("Node::ReadSequence", count, read.seconds());
+  sink = sink + values.size();
+
+  // the same conversions over the scalars' text, without the nodes: what
+  // faster digit parsing could save at most
+  std::vector<std::string> scalars;
+  scalars.reserve(count);
+  for (std::size_t i = 0; i < count; i++)
+    scalars.push_back(doc[i].Scalar());
+  Timer convert;
+  for (std::size_t i = 0; i < count; i++) {
+    int value = 0;
+    YAML::Convert(scalars[i], value);
+    sink = sink + value;
+  }
+  Report("Convert (same scalars)", count, convert.seconds());
+
+  doc.CacheConversions();
+  Timer cached;
+  doc.ReadSequence(values);
+  Report("ReadSequence (cached)", count, cached.seconds());
+  sink = sink + values.size();
+
+  std::stringstream stream2(input);
+  YAML::Parser parser2(stream2);
+  YAML::SequenceReader<int> reader(values);
+  Timer events;
+  parser2.HandleNextDocument(reader);
+  Report("parse with SequenceReader", count, events.seconds());
+  sink = sink + values.size();
+}
+
+////////////////////////////////////////////////////////////////
+// struct: decoding a config into a struct
+
+struct Server {
+  std::string host;
+  int port;
+  bool enabled;
+  double weight;
+  std::vector<std::string> tags;
+};
+}
+
+YAML_BEGIN_FIELDS(Server)
+  YAML_FIELD(host)
+  YAML_FIELD(port)
+  YAML_FIELD(enabled)
+  YAML_FIELD(weight)
+  YAML_FIELD(tags)
+YAML_END_FIELDS()
+
+namespace {
+const char serverConfig[] =
+    "host: example.com\n"
+    "comment: this key isn't decoded\n"
+    "port: 8080\n"
+    "enabled: true\n"
+    "weight: 0.75\n"
+    "tags: [web, primary, eu-west]\n";
+
+void BenchStruct() {
+  const std::size_t rounds = 5000;
+  Server server;
+
+  Timer nodes;
+  for (std::size_t i = 0; i < rounds; i++) {
+    std::stringstream stream(serverConfig);
+    YAML::Parser parser(stream);
+    YAML::Node doc;
+    parser.GetNextDocument(doc);
+    doc["host"] >> server.host;
+    doc["port"] >> server.port;
+    doc["enabled"] >> server.enabled;
+    doc["weight"] >> server.weight;
+    doc["tags"] >> server.tags;
+  }
+  Report("Node, then operator>>", rounds, nodes.seconds());
+
+  Timer decoder;
+  for (std::size_t i = 0; i < rounds; i++) {
+    std::stringstream stream(serverConfig);
+    YAML::Parser parser(stream);
+    YAML::StructDecoder<Server> decode(server);
+    parser.HandleNextDocument(decode);
+  }
+  Report("StructDecoder", rounds, decoder.seconds());
+  sink = sink + server.port;
+}
+
+////////////////////////////////////////////////////////////////
+// lookup: finding a value by a user-defined key
+
+// reads through operator >>, which throws on keys that aren't pairs
+struct ThrowingKey {
+  int x, y;
+  bool operator==(const ThrowingKey& rhs) const {
+    return x == rhs.x && y == rhs.y;
+  }
+};
+
+void operator>>(const YAML::Node& node, ThrowingKey& key) {
+  node[0] >> key.x;
+  node[1] >> key.y;
+}
+
+// reads through TryDecode
+struct DecodedKey {
+  int x, y;
+  bool operator==(const DecodedKey& rhs) const {
+    return x == rhs.x && y == rhs.y;
+  }
+};
+
+bool TryDecode(const YAML::Node& node, DecodedKey& key) {
+  return node.Type() == YAML::NodeType::Sequence && node.size() == 2 &&
+         node[0].Read(key.x) && node[1].Read(key.y);
+}
+
+template <typename Key>
+void BenchLookup(const char* label, const YAML::Node& doc, std::size_t keys) {
+  const std::size_t rounds = 200;
+  Timer lookup;
+  for (std::size_t r = 0; r < rounds; r++) {
+    // every other lookup misses, and so reads every key
+    const int i = static_cast<int>(r / 2 % keys);
+    Key key = {i, r % 2 ? -1 : i};
+    const YAML::Node* pValue = doc.FindValue(key);
+    sink = sink + (pValue != 0);
+  }
+  Report(label, rounds, lookup.seconds());
+}
+
+void BenchLookup() {
+  // half the keys are pairs, half are strings that no pair matches
+  const std::size_t keys = 500;
+  std::stringstream input;
+  for (std::size_t i = 0; i < keys; i++)
+    input << "[" << i << ", " << i << "]: " << i << "\nkey" << i << ": " << i
+          << "\n";
+
+  YAML::Parser parser(input);
+  YAML::Node doc;
+  parser.GetNextDocument(doc);
+
+  BenchLookup<ThrowingKey>("FindValue (operator>>)", doc, keys);
+  BenchLookup<DecodedKey>("FindValue (TryDecode)", doc, keys);
+}
+
+////////////////////////////////////////////////////////////////
+// emit: writing numbers with the Emitter
+
+template <typename T>
+void BenchEmit(const char* type, T first, T step) {
+  const std::size_t count = 500000;
+  std::string label;
+
+  // what the Emitter used to do for each number
+  Timer stream;
+  for (std::size_t i = 0; i < count; i++) {
+    std::stringstream formatted;
+    formatted.precision(16);
+    formatted << first + static_cast<T>(i) * step;
+    sink = sink + formatted.str().size();
+  }
+  label = std::string(type) + " (stringstream only)";
+  Report(label.c_str(), count, stream.seconds());
+
+  YAML::Emitter out;
+  Timer emit;
+  out << YAML::Flow << YAML::BeginSeq;
+  for (std::size_t i = 0; i < count; i++)
+    out << first + static_cast<T>(i) * step;
+  out << YAML::EndSeq;
+  label = std::string(type) + " (Emitter)";
+  Report(label.c_str(), count, emit.seconds());
+  sink = sink + out.size();
+}
+
+void BenchEmit() {
+  BenchEmit<int>("int", -250000, 1);
+  BenchEmit<long long>("long long", 1000000007LL, 7919);
+  BenchEmit<double>("double", 0.001, 3.14159);
+}
+
+////////////////////////////////////////////////////////////////
+// stream: emitting a large document to a std::ostream
+
+void EmitRecords(YAML::Emitter& out, std::size_t count) {
+  out << YAML::BeginSeq;
+  for (std::size_t i = 0; i < count; i++) {
+    out << YAML::BeginMap;
+    out << YAML::Key << "id" << YAML::Value << i;
+    out << YAML::Key << "name" << YAML::Value << "record";
+    out << YAML::Key << "tags" << YAML::Value << YAML::BeginSeq << "a" << "b"
+        << YAML::EndSeq;
+    out << YAML::EndMap;
+  }
+  out << YAML::EndSeq;
+}
+
+void BenchStream() {
+  const std::size_t count = 50000;
+
+  std::stringstream direct;
+  Timer unbuffered;
+  {
+    YAML::Emitter out(direct, 0);
+    EmitRecords(out, count);
+  }
+  Report("each piece to the stream", count, unbuffered.seconds());
+
+  std::stringstream blocks;
+  Timer buffered;
+  {
+    YAML::Emitter out(blocks);
+    EmitRecords(out, count);
+  }
+  Report("in blocks", count, buffered.seconds());
+  sink = sink + direct.str().size() + blocks.str().size();
+}
+
+////////////////////////////////////////////////////////////////
+// wrapper: ostream_wrapper::write on long pieces (like base64 lines), and
+// on short ones
+
+void BenchWrapper() {
+  const std::size_t rounds = 2000;
+  std::string piece;
+  for (std::size_t i = 0; i < 64; i++)
+    piece += std::string(76, 'A' + i % 26) + "\n";
+
+  YAML::ostream_wrapper wrapper;
+  Timer write;
+  for (std::size_t i = 0; i < rounds; i++)
+    wrapper.write(piece);
+  Report("write (per KiB)", rounds * piece.size() / 1024, write.seconds());
+  sink = sink + wrapper.row();
+
+  // short pieces, as the Emitter writes them
+  const std::size_t count = 4000000;
+  YAML::ostream_wrapper shortWrapper;
+  Timer writeShort;
+  for (std::size_t i = 0; i < count; i++)
+    shortWrapper.write("key: ", 5);
+  Report("write 5 characters", count, writeShort.seconds());
+  sink = sink + shortWrapper.pos();
+}
+
+////////////////////////////////////////////////////////////////
+// strings: writing typical strings with the Emitter
+
+const char* const emittedStrings[] = {
+    "name", "example.com", "The quick brown fox jumps over the lazy dog",
+    "/usr/local/share/yaml-cpp", "key: with a colon", "2024-01-01T00:00:00Z",
+    "a fairly long description of something, with a comma in it",
+    "caf\xC3\xA9 au lait"};
+
+void BenchStrings() {
+  const std::size_t rounds = 50000;
+  const std::size_t count = sizeof(emittedStrings) / sizeof(char*);
+  std::vector<std::string> strings(emittedStrings, emittedStrings + count);
+
+  YAML::Emitter out;
+  Timer emit;
+  out << YAML::BeginSeq;
+  for (std::size_t r = 0; r < rounds; r++) {
+    for (std::size_t i = 0; i < count; i++)
+      out << strings[i];
+  }
+  out << YAML::EndSeq;
+  Report("Emitter << std::string", rounds * count, emit.seconds());
+  sink = sink + out.size();
+
+  YAML::Emitter quoted;
+  Timer emitQuoted;
+  quoted << YAML::BeginSeq;
+  for (std::size_t r = 0; r < rounds; r++) {
+    for (std::size_t i = 0; i < count; i++)
+      quoted << YAML::DoubleQuoted << strings[i];
+  }
+  quoted << YAML::EndSeq;
+  Report("... DoubleQuoted", rounds * count, emitQuoted.seconds());
+
+  YAML::Emitter single;
+  Timer emitSingle;
+  single << YAML::BeginSeq;
+  for (std::size_t r = 0; r < rounds; r++) {
+    for (std::size_t i = 0; i < count; i++)
+      single << YAML::SingleQuoted << strings[i];
+  }
+  single << YAML::EndSeq;
+  Report("... SingleQuoted", rounds * count, emitSingle.seconds());
+  sink = sink + quoted.size() + single.size();
+}
+
+////////////////////////////////////////////////////////////////
+// manips: small nodes with local manipulators (each one a setting change)
+
+void BenchManips() {
+  const std::size_t count = 200000;
+
+  YAML::Emitter out;
+  Timer emit;
+  out << YAML::BeginSeq;
+  for (std::size_t i = 0; i < count; i++) {
+    out << YAML::Flow << YAML::BeginMap;
+    out << YAML::Key << "id" << YAML::Value << YAML::Hex << i;
+    out << YAML::Key << "on" << YAML::Value << YAML::YesNoBool << true;
+    out << YAML::EndMap;
+  }
+  out << YAML::EndSeq;
+  Report("flow map, Hex, YesNoBool", count, emit.seconds());
+  sink = sink + out.size();
+}
+
+////////////////////////////////////////////////////////////////
+// reuse: a small document per request, with a new or a Reset() Emitter
+
+void BenchReuse() {
+  const std::size_t requests = 20000;
+
+  Timer fresh;
+  for (std::size_t i = 0; i < requests; i++) {
+    YAML::Emitter out;
+    EmitRecords(out, 20);
+    sink = sink + out.size();
+  }
+  Report("new Emitter", requests, fresh.seconds());
+
+  YAML::Emitter out(4096);
+  Timer reset;
+  for (std::size_t i = 0; i < requests; i++) {
+    out.Reset();
+    EmitRecords(out, 20);
+    sink = sink + out.size();
+  }
+  Report("Reset()", requests, reset.seconds());
+}
+
+////////////////////////////////////////////////////////////////
+// json: records as JSON, through the Emitter (flow, double-quoted) and the
+// JsonEmitter
+
+template <typename E>
+void EmitJsonRecords(E& out, std::size_t count) {
+  out << YAML::BeginSeq;
+  for (std::size_t i = 0; i < count; i++) {
+    out << YAML::BeginMap;
+    out << YAML::Key << "id" << YAML::Value << i;
+    out << YAML::Key << "name" << YAML::Value << "record name";
+    out << YAML::Key << "score" << YAML::Value << 0.25 * i;
+    out << YAML::Key << "active" << YAML::Value << (i % 2 == 0);
+    out << YAML::EndMap;
+  }
+  out << YAML::EndSeq;
+}
+
+void BenchJson() {
+  const std::size_t count = 200000;
+
+  YAML::Emitter emitter;
+  emitter.SetSeqFormat(YAML::Flow);
+  emitter.SetStringFormat(YAML::DoubleQuoted);
+  Timer emit;
+  EmitJsonRecords(emitter, count);
+  Report("Emitter (Flow, DoubleQuoted)", count, emit.seconds());
+
+  YAML::JsonEmitter json;
+  Timer emitJson;
+  EmitJsonRecords(json, count);
+  Report("JsonEmitter", count, emitJson.seconds());
+  sink = sink + emitter.size() + json.size();
+}
+
+////////////////////////////////////////////////////////////////
+// base64: a 4 MB blob, whole and in 64 KB chunks (ns per byte)
+
+void BenchBase64() {
+  const std::size_t size = 4 << 20, chunk = 64 << 10, rounds = 20;
+  std::vector<unsigned char> data(size);
+  for (std::size_t i = 0; i < size; i++)
+    data[i] = static_cast<unsigned char>(i * 2654435761u >> 13);
+
+  std::string encoded;
+  Timer encode;
+  for (std::size_t r = 0; r < rounds; r++)
+    encoded = YAML::EncodeBase64(&data[0], size);
+  Report("EncodeBase64", rounds * size, encode.seconds());
+
+  std::string chunkOutput;
+  Timer encodeChunks;
+  for (std::size_t r = 0; r < rounds; r++) {
+    YAML::Base64Encoder encoder;
+    for (std::size_t i = 0; i < size; i += chunk) {
+      chunkOutput.clear();
+      encoder.Encode(&data[i], chunk, chunkOutput);
+      sink = sink + chunkOutput.size();
+    }
+    encoder.Finish(chunkOutput);
+  }
+  Report("Base64Encoder", rounds * size, encodeChunks.seconds());
+
+  std::vector<unsigned char> decoded;
+  Timer decode;
+  for (std::size_t r = 0; r < rounds; r++)
+    decoded = YAML::DecodeBase64(encoded);
+  Report("DecodeBase64", rounds * size, decode.seconds());
+
+  std::vector<unsigned char> chunkDecoded;
+  Timer decodeChunks;
+  for (std::size_t r = 0; r < rounds; r++) {
+    YAML::Base64Decoder decoder;
+    for (std::size_t i = 0; i < encoded.size(); i += chunk) {
+      chunkDecoded.clear();
+      decoder.Decode(encoded.data() + i,
+                     std::min(chunk, encoded.size() - i), chunkDecoded);
+      sink = sink + chunkDecoded.size();
+    }
+  }
+  Report("Base64Decoder", rounds * size, decodeChunks.seconds());
+  sink = sink + (decoded == data);
+
+  // each kernel the CPU runs, on the same data
+  const YAML::Base64Kernel::value best = YAML::GetBase64Kernel();
+  const struct {
+    YAML::Base64Kernel::value kernel;
+    const char* name;
+  } kernels[] = {{YAML::Base64Kernel::Tables, "tables"},
+                 {YAML::Base64Kernel::Ssse3, "SSSE3"},
+                 {YAML::Base64Kernel::Avx2, "AVX2"}};
+  for (std::size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+    if (!YAML::SetBase64Kernel(kernels[k].kernel))
+      continue;
+    std::string label;
+
+    Timer kernelEncode;
+    for (std::size_t r = 0; r < rounds; r++)
+      encoded = YAML::EncodeBase64(&data[0], size);
+    label = std::string("EncodeBase64 (") + kernels[k].name + ")";
+    Report(label.c_str(), rounds * size, kernelEncode.seconds());
+
+    Timer kernelDecode;
+    for (std::size_t r = 0; r < rounds; r++)
+      decoded = YAML::DecodeBase64(encoded);
+    label = std::string("DecodeBase64 (") + kernels[k].name + ")";
+    Report(label.c_str(), rounds * size, kernelDecode.seconds());
+    sink = sink + (decoded == data);
+  }
+  YAML::SetBase64Kernel(best);
+}
+
+////////////////////////////////////////////////////////////////
+// binary: a 16 MB !!binary node, emitted to a sink and parsed back (ns per
+// byte)
+
+void Discard(void*, const char* data, std::size_t size) {
+  sink = sink + data[size - 1];
+}
+
+std::size_t ProduceBytes(void* context, unsigned char* buffer,
+                         std::size_t size) {
+  std::size_t& left = *static_cast<std::size_t*>(context);
+  const std::size_t n = std::min(left, size);
+  for (std::size_t i = 0; i < n; i++)
+    buffer[i] = static_cast<unsigned char>(i * 2654435761u >> 13);
+  left -= n;
+  return n;
+}
+
+void BenchBinary() {
+  const std::size_t size = 16 << 20;
+  std::vector<unsigned char> data(size);
+  for (std::size_t i = 0; i < size; i++)
+    data[i] = static_cast<unsigned char>(i * 2654435761u >> 13);
+
+  YAML::CallbackSink callbackSink(Discard, 0);
+  YAML::Emitter out(callbackSink);
+  Timer emit;
+  out << YAML::Binary(&data[0], size);
+  Report("Emitter << Binary", size, emit.seconds());
+
+  YAML::Emitter streamOut(callbackSink);
+  std::size_t left = size;
+  Timer emitStream;
+  streamOut << YAML::BinaryStream(ProduceBytes, &left);
+  Report("Emitter << BinaryStream", size, emitStream.seconds());
+
+  std::string document = "!!binary \"" + YAML::EncodeBase64(&data[0], size) +
+                         "\"";
+  std::stringstream stream(document);
+  YAML::Parser parser(stream);
+  YAML::Node doc;
+  parser.GetNextDocument(doc);
+
+  YAML::Binary binary;
+  Timer read;
+  doc >> binary;
+  Report("Node >> Binary", size, read.seconds());
+
+  std::size_t decoded = 0;
+  Timer decode;
+  YAML::DecodeBinary(doc, &data[0], size, decoded);
+  Report("DecodeBinary", size, decode.seconds());
+  sink = sink + binary.size() + decoded;
+}
+
+////////////////////////////////////////////////////////////////
+// numseq: 10M-element vectors of numbers, an element at a time and with
+// EmitSeq (ns per element; the output is discarded)
+
+template <typename T>
+void BenchNumberSeq(const char* type, const std::vector<T>& values,
+                    YAML::EMITTER_MANIP format) {
+  YAML::CallbackSink callbackSink(Discard, 0);
+  std::string label;
+
+  YAML::Emitter single(callbackSink);
+  Timer emitSingle;
+  single << format << YAML::BeginSeq;
+  for (std::size_t i = 0; i < values.size(); i++)
+    single << values[i];
+  single << YAML::EndSeq;
+  label = std::string(type) + (format == YAML::Flow ? ", flow" : ", block");
+  Report((label + ", one at a time").c_str(), values.size(),
+         emitSingle.seconds());
+
+  YAML::Emitter bulk(callbackSink);
+  Timer emitBulk;
+  bulk << format;
+  YAML::EmitSeq(bulk, values);
+  Report((label + ", EmitSeq").c_str(), values.size(), emitBulk.seconds());
+}
+
+void BenchNumberSeq() {
+  const std::size_t count = 10000000;
+  std::vector<int> integers(count);
+  std::vector<double> doubles(count);
+  for (std::size_t i = 0; i < count; i++) {
+    integers[i] = static_cast<int>(i * 2654435761u >> 8) - (1 << 23);
+    doubles[i] = integers[i] / 1024.0;
+  }
+
+  BenchNumberSeq("int", integers, YAML::Flow);
+  BenchNumberSeq("int", integers, YAML::Block);
+  BenchNumberSeq("double", doubles, YAML::Flow);
+  BenchNumberSeq("double", doubles, YAML::Block);
+}
+
+////////////////////////////////////////////////////////////////
+// pool: a document whose scalars repeat, parsed with and without a
+// StringPool, and the heap it keeps
+
+std::string RepeatedScalarsDocument(std::size_t count) {
+  static const char* const hosts[] = {
+      "db-primary.us-east-1.example.com", "db-replica.us-east-1.example.com",
+      "cache-01.eu-west-2.example.com", "cache-02.eu-west-2.example.com"};
+  std::stringstream stream;
+  for (std::size_t i = 0; i < count; i++) {
+    stream << "- {host: " << hosts[i % 4]
+           << ", port: 5432, enabled: true, role: read-replica-secondary,"
+           << " region: us-east-1a}\n";
+  }
+  return stream.str();
+}
+
+void BenchPool(const char* label, const std::string& input, bool pooled) {
+  const std::size_t before = liveHeapBytes;
+  std::stringstream stream(input);
+  YAML::Parser parser(stream);
+  YAML::StringPool pool;
+  YAML::Node doc;
+
+  Timer parse;
+  if (pooled)
+    parser.GetNextDocument(doc, pool);
+  else
+    parser.GetNextDocument(doc);
+  const double seconds = parse.seconds();
+
+  std::string name = std::string("parse ") + label;
+  Report(name.c_str(), doc.size(), seconds);
+  name = std::string("live heap ") + label;
+  std::printf("  %-32s %10.1f bytes/item\n", name.c_str(),
+              static_cast<double>(liveHeapBytes - before) / doc.size());
+}
+
+void BenchPool() {
+  const std::string input = RepeatedScalarsDocument(20000);
+  std::printf("  sizeof(YAML::Node) %u\n",
+              static_cast<unsigned>(sizeof(YAML::Node)));
+  BenchPool("(no pool)", input, false);
+  BenchPool("(StringPool)", input, true);
+}
+
+struct Benchmark {
+  const char* name;
+  void (*run)();
+};
+
+const Benchmark benchmarks[] = {{"numbers", BenchNumbers},
+                                {"sequence", BenchSequence},
+                                {"struct", BenchStruct},
+                                {"lookup", BenchLookup},
+                                {"emit", BenchEmit},
+                                {"stream", BenchStream},
+                                {"wrapper", BenchWrapper},
+                                {"strings", BenchStrings},
+                                {"manips", BenchManips},
+                                {"reuse", BenchReuse},
+                                {"json", BenchJson},
+                                {"base64", BenchBase64},
+                                {"binary", BenchBinary},
+                                {"numseq", BenchNumberSeq},
+                                {"pool", BenchPool}, };
+}
+
+int main(int argc, char** argv) {
+  const std::size_t count = sizeof(benchmarks) / sizeof(benchmarks[0]);
+  for (std::size_t i = 0; i < count; i++) {
+    bool selected = argc <= 1;
+    for (int j = 1; j < argc; j++)
+      selected = selected || std::strcmp(argv[j], benchmarks[i].name) == 0;
+    if (!selected)
+      continue;
+
+    std::printf("%s\n", benchmarks[i].name);
+    benchmarks[i].run();
+  }
+  return 0;
+}
@@ -0,0 +1,67 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "yaml-cpp/yaml.h"  // IWYU pragma: keep
+
+// transcode [--block | --flow] [--indent N]
+//           [--single-quoted | --double-quoted | --literal] [--json] [file]
+// . Reformats YAML from 'file' (or stdin) to stdout, streaming, so the
+//   documents never have to fit in memory.
+// . With --json, writes each document as a line of JSON instead.
+
+namespace {
+void Usage() {
+  std::cerr << "usage: transcode [--block | --flow] [--indent N]\n"
+               "                 [--single-quoted | --double-quoted | "
+               "--literal] [--json] [file]\n";
+}
+}
+
+int main(int argc, char** argv) {
+  YAML::TranscodeOptions options;
+  const char* fileName = 0;
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    if (std::strcmp(arg, "--block") == 0) {
+      options.style = YAML::EmitterStyle::Block;
+    } else if (std::strcmp(arg, "--flow") == 0) {
+      options.style = YAML::EmitterStyle::Flow;
+    } else if (std::strcmp(arg, "--indent") == 0 && i + 1 < argc) {
+      options.indent = std::atoi(argv[++i]);
+    } else if (std::strcmp(arg, "--single-quoted") == 0) {
+      options.stringFormat = YAML::SingleQuoted;
+    } else if (std::strcmp(arg, "--double-quoted") == 0) {
+      options.stringFormat = YAML::DoubleQuoted;
+    } else if (std::strcmp(arg, "--literal") == 0) {
+      options.stringFormat = YAML::Literal;
+    } else if (std::strcmp(arg, "--json") == 0) {
+      options.json = true;
+    } else if (arg[0] != '-' && !fileName) {
+      fileName = arg;
+    } else {
+      Usage();
+      return 2;
+    }
+  }
+
+  try {
+    if (fileName) {
+      std::ifstream fin(fileName);
+      if (!fin) {
+        std::cerr << "can't open " << fileName << "\n";
+        return 1;
+      }
+      YAML::Transcode(fin, std::cout, options);
+    } else {
+      YAML::Transcode(std::cin, std::cout, options);
+    }
+  }
+  catch (const YAML::Exception& e) {
+    std::cerr << e.what() << "\n";
+    return 1;
+  }
+  return 0;
+}